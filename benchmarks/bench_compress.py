@@ -0,0 +1,85 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures writing gzip compressed man pages (--compress gzip).
+# The baseline writes uncompressed man pages and then compresses every file in a separate pass,
+# like a packaging step would. Compression in manos is measured on the rendering thread
+# (--write-queue 0) and on the pool of compression threads.
+# Every compressed page is compared against its uncompressed counterpart.
+#
+# Run from the repository root with: python -m benchmarks.bench_compress
+
+from typing import Callable, Optional, Tuple
+
+import gzip
+import io
+import os
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+def run(xml_dir: str, output_dir: str, compress: Optional[str], depth: int) -> float:
+    session = manos.Session(manos.Arguments())
+    session.args.output = output_dir
+    session.args.compress = compress
+    session.args.write_queue = depth
+    session.args.stdout = io.StringIO()
+    start = time.perf_counter()
+    assert manos.process_xml(session, xml_dir) == 0
+    return time.perf_counter() - start
+
+# Compress every man page in the directory, like a separate packaging step.
+def compress_pass(output_dir: str) -> float:
+    start = time.perf_counter()
+    for name in os.listdir(output_dir):
+        path = os.path.join(output_dir, name)
+        with open(path, "rb") as fp:
+            data = fp.read()
+        with open(path + ".gz", "wb") as fp:
+            fp.write(gzip.compress(data, 9, mtime=0))
+        os.remove(path)
+    return time.perf_counter() - start
+
+# The best of three runs, each in a new output directory so every page is written.
+def measure(directory: str, label: str, function: Callable[[str], float]) -> Tuple[float, str]:
+    best = float("inf")
+    for attempt in range(3):
+        output_dir = os.path.join(directory, f"{label}{attempt}")
+        os.makedirs(output_dir)
+        best = min(best, function(output_dir))
+    return best, output_dir
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=100, functions=20, blocks=4)
+        baseline, baseline_dir = measure(directory, "baseline", lambda output_dir: run(xml_dir, output_dir, None, 16) + compress_pass(output_dir))
+        serial, serial_dir = measure(directory, "serial", lambda output_dir: run(xml_dir, output_dir, "gzip", 0))
+        pool, pool_dir = measure(directory, "pool", lambda output_dir: run(xml_dir, output_dir, "gzip", 16))
+        print(f"{len(os.listdir(baseline_dir))} pages, {os.cpu_count()} CPUs")
+        print(f"separate gzip pass: {baseline:7.3f}s")
+        print(f"--write-queue 0:    {serial:7.3f}s ({baseline / serial:.2f}x)")
+        print(f"compression pool:   {pool:7.3f}s ({baseline / pool:.2f}x)")
+
+        for name in os.listdir(baseline_dir):
+            with open(os.path.join(baseline_dir, name), "rb") as fp:
+                expected = fp.read()
+            for output_dir in [serial_dir, pool_dir]:
+                with open(os.path.join(output_dir, name), "rb") as fp:
+                    assert fp.read() == expected, f"{name} differs from the separate gzip pass"
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,82 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+# Measures rendering struct-heavy headers when field descriptions and \param lists are only
+# rendered if a man page section emits them. The baseline renders them all eagerly, like the
+# previous implementation, including those that no section emits with the default options.
+#
+# Run from the repository root with: python -m benchmarks.bench_deferred
+
+from typing import List, Tuple
+
+import glob
+import os
+import tempfile
+import time
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import generate
+
+# The previous handler, which rendered every \param list as soon as it was encountered.
+def eager_parameterlist(ctx: manos.Context, elem: lxml.etree._Element) -> manos.Roff:
+    if elem.get("kind") == "param":
+        ctx.function_params = manos.render_parameters(ctx, elem)
+        return manos.Roff()
+    return manos.process_parameterlist(ctx, elem)
+
+# Discover the symbols, render every struct and union, and then every header.
+def render(xml_dir: str, eager: bool) -> Tuple[List[manos.Page], float]:
+    session = manos.Session(manos.Arguments())
+    session.args.stdout = open(os.devnull, "w")
+    trees: List[lxml.etree._ElementTree] = []
+    for file in sorted(glob.glob(os.path.join(xml_dir, "*.xml"))):
+        tree = lxml.etree.parse(file)
+        if manos.preparse_xml(session, tree):
+            trees.append(tree)
+    manos.link_groups(session)
+    manos.link_references(session)
+
+    start = time.perf_counter()
+    if eager:
+        # The previous implementation rendered the description of every field.
+        for compound in session.state.compounds.values():
+            if isinstance(compound, manos.CompositeType) and compound.element is not None:
+                for memberdef in compound.element.iter("memberdef"):
+                    manos.process_as_roff(manos.Context(session), memberdef.find("detaileddescription"))
+    manos.parse_composites(session)
+    pages = [page for tree in trees for page in manos.parse_xml(session, tree)]
+    elapsed = time.perf_counter() - start
+    session.args.stdout.close()
+    return pages, elapsed
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=60, functions=10, blocks=2)
+        lazy, lazy_time = render(xml_dir, False)
+        manos.register_handler("parameterlist", eager_parameterlist)
+        try:
+            baseline, baseline_time = render(xml_dir, True)
+        finally:
+            manos.register_handler("parameterlist", manos.process_parameterlist)
+        assert lazy == baseline
+
+        print(f"{len(lazy)} pages")
+        print(f"eager:    {baseline_time:7.3f}s")
+        print(f"deferred: {lazy_time:7.3f}s ({lazy_time / baseline_time:.0%} of baseline)")
+
+if __name__ == "__main__":
+    main()
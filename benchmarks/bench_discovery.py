@@ -0,0 +1,61 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Compares peak memory of symbol discovery with and without the streaming parser.
+# Each measurement runs in a fresh process because the peak resident set size
+# reported by the operating system never decreases within a process.
+#
+# Run from the repository root with: python -m benchmarks.bench_discovery
+
+import glob
+import multiprocessing
+import os
+import resource
+import tempfile
+import time
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import generate
+
+def discover(xml_dir: str, streaming: bool, results: "multiprocessing.Queue[str]") -> None:
+    session = manos.Session(manos.Arguments())
+    start = time.perf_counter()
+    for file in glob.glob(os.path.join(xml_dir, "*.xml")):
+        if streaming:
+            manos.preparse_xml_streaming(session, file)
+        else:
+            # Drop the tree immediately; only the discovery cost is of interest.
+            manos.preparse_xml(session, lxml.etree.parse(file))
+    elapsed = time.perf_counter() - start
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss // 1024
+    results.put(f"streaming={streaming!s:<5}: {elapsed:7.3f}s, peak RSS {peak} MiB, {len(session.state.compounds)} symbols")
+
+def main() -> None:
+    context = multiprocessing.get_context("spawn")
+    with tempfile.TemporaryDirectory() as directory:
+        # A handful of very large headers is the worst case for tree-based discovery.
+        xml_dir = generate(directory, headers=4, functions=5000)
+        size = sum(os.path.getsize(file) for file in glob.glob(os.path.join(xml_dir, "*.xml")))
+        print(f"{size // (1024 * 1024)} MiB of XML")
+        for streaming in [False, True]:
+            results: "multiprocessing.Queue[str]" = context.Queue()
+            process = context.Process(target=discover, args=(xml_dir, streaming, results))
+            process.start()
+            print(results.get())
+            process.join()
+
+if __name__ == "__main__":
+    main()
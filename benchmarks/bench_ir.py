@@ -0,0 +1,89 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Reports the allocations made while rendering man pages.
+# For every header, the peak memory traced by tracemalloc while rendering it (the header page
+# and the pages of its functions) is recorded, along with the number of objects of the
+# intermediate representation (Roff buffers and their entries) that were constructed.
+#
+# Run from the repository root with: python -m benchmarks.bench_ir
+
+from typing import Any, List
+
+import glob
+import os
+import tempfile
+import time
+import tracemalloc
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import generate
+
+IR = [manos.Roff, manos.Text, manos.Span, manos.Macro, manos.CodeLine]
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=20, functions=40, blocks=6)
+        session = manos.Session(manos.Arguments())
+        headers: List[lxml.etree._ElementTree] = []
+        for file in sorted(glob.glob(os.path.join(xml_dir, "*.xml"))):
+            tree = lxml.etree.parse(file)
+            if manos.preparse_xml(session, tree):
+                headers.append(tree)
+        manos.link_groups(session)
+        manos.link_references(session)
+
+        # Count constructions of the intermediate representation.
+        constructed = 0
+        originals = {cls: cls.__init__ for cls in IR}
+        for cls, original in originals.items():
+            def counted(self: Any, *parameters: Any, original: Any = original) -> None:
+                nonlocal constructed
+                constructed += 1
+                original(self, *parameters)
+            cls.__init__ = counted # type: ignore
+
+        peaks: List[int] = []
+        pages = 0
+        elapsed = 0.0
+        tracemalloc.start()
+        for tree in headers:
+            tracemalloc.reset_peak()
+            before, _ = tracemalloc.get_traced_memory()
+            start = time.perf_counter()
+            rendered = manos.parse_xml(session, tree)
+            elapsed += time.perf_counter() - start
+            _, peak = tracemalloc.get_traced_memory()
+            peaks.append(peak - before)
+            pages += len(rendered)
+            del rendered
+        tracemalloc.stop()
+
+        # Time without tracing, which distorts timings.
+        for cls, original in originals.items():
+            cls.__init__ = original # type: ignore
+        start = time.perf_counter()
+        for tree in headers:
+            manos.parse_xml(session, tree)
+        untraced = time.perf_counter() - start
+
+        print(f"{len(headers)} headers, {pages} pages")
+        print(f"IR objects constructed per page: {constructed / pages:8.1f}")
+        print(f"peak traced memory per header: mean {sum(peaks) / len(peaks) / 1024:8.1f} KiB, max {max(peaks) / 1024:8.1f} KiB")
+        print(f"render time: {untraced:.3f}s ({elapsed:.3f}s traced)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,53 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures how rendering scales with the number of worker processes (--jobs).
+# The output of every run is compared against the serial run to confirm it is byte-identical.
+#
+# Run from the repository root with: python -m benchmarks.bench_jobs
+
+from typing import Dict
+
+import filecmp
+import os
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+def run(xml_dir: str, output_dir: str, jobs: int) -> float:
+    os.makedirs(output_dir)
+    session = manos.Session(manos.Arguments())
+    session.args.output = output_dir
+    session.args.jobs = jobs
+    start = time.perf_counter()
+    assert manos.process_xml(session, xml_dir) == 0
+    return time.perf_counter() - start
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=200, functions=20)
+        timings: Dict[int, float] = {}
+        for jobs in [1, 2, 4, 8]:
+            output_dir = os.path.join(directory, f"man{jobs}")
+            timings[jobs] = run(xml_dir, output_dir, jobs)
+            serial = os.path.join(directory, "man1")
+            mismatches = filecmp.dircmp(serial, output_dir).diff_files
+            assert len(mismatches) == 0, f"output differs from serial run: {mismatches}"
+            print(f"jobs={jobs}: {timings[jobs]:7.3f}s ({timings[1] / timings[jobs]:.2f}x)")
+
+if __name__ == "__main__":
+    main()
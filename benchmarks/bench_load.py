@@ -0,0 +1,47 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures the wall time of loading a large XML directory with a varying number of loader threads.
+# Each tree is handed to preparse_xml() so the loader overlaps with Python-level discovery,
+# just like it does during a real run.
+#
+# Run from the repository root with: python -m benchmarks.bench_load
+
+import glob
+import os
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=400, functions=30)
+        xml_files = sorted(glob.glob(os.path.join(xml_dir, "*.xml")))
+        serial = 0.0
+        for threads in [1, 2, 4, 8]:
+            session = manos.Session(manos.Arguments())
+            session.args.load_threads = threads
+            start = time.perf_counter()
+            for _, tree in manos.load_xml(session.args, xml_files):
+                manos.preparse_xml(session, tree)
+            elapsed = time.perf_counter() - start
+            if threads == 1:
+                serial = elapsed
+            print(f"load_threads={threads}: {elapsed:7.3f}s (saves {serial - elapsed:6.3f}s, {serial / elapsed:.2f}x)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,60 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+# Measures the peak resident memory of a run with and without --low-memory as the project grows.
+# Every header is the same size so, in low memory mode, peak memory should stay roughly flat
+# while the default mode grows with the number of headers, structs, and examples.
+# Each run happens in a fresh process so its peak is not inherited from an earlier run.
+#
+# Run from the repository root with: python -m benchmarks.bench_memory
+
+import io
+import os
+import resource
+import subprocess
+import sys
+import tempfile
+
+import manos
+from .synthetic import generate
+
+# Render the project in 'xml_dir' and print the peak resident memory of this process in KiB.
+def child(xml_dir: str, output_dir: str, low_memory: bool) -> None:
+    assert manos.process(xml_dir=xml_dir, output_dir=output_dir, low_memory=low_memory, stdout=io.StringIO()) == 0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform == "darwin":
+        peak //= 1024 # Reported in bytes rather than KiB.
+    print(peak)
+
+def measure(xml_dir: str, output_dir: str, low_memory: bool) -> int:
+    command = [sys.executable, "-m", "benchmarks.bench_memory", xml_dir, output_dir, str(low_memory)]
+    return int(subprocess.check_output(command))
+
+def main() -> None:
+    print(f"{'headers':>8} {'default':>12} {'low memory':>12}")
+    for headers in [25, 100, 400]:
+        with tempfile.TemporaryDirectory() as directory:
+            xml_dir = generate(directory, headers=headers, functions=20, blocks=4)
+            output_dir = os.path.join(directory, "man")
+            default = measure(xml_dir, output_dir, False)
+            low_memory = measure(xml_dir, output_dir, True)
+            print(f"{headers:>8} {default / 1024:9.1f} MiB {low_memory / 1024:9.1f} MiB")
+
+if __name__ == "__main__":
+    if len(sys.argv) == 4:
+        child(sys.argv[1], sys.argv[2], sys.argv[3] == "True")
+    else:
+        main()
@@ -0,0 +1,101 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+# Measures building the SEE ALSO list of every function in a group of 10k functions.
+# Each function page combines the functions of its group and discards its own name.
+# The baseline is the previous list-backed implementation, which rewrote the index of
+# every element on removal and built new sets for every union and difference.
+#
+# Run from the repository root with: python -m benchmarks.bench_ordered_set
+
+from typing import Callable, Dict, List
+
+import time
+
+from manos.ordered_set import OrderedSet
+
+# The previous implementation of the operations used by parse_function(), kept for comparison.
+class ListOrderedSet:
+    def __init__(self, initial: List[str] = []):
+        self.items: List[str] = []
+        self.map: Dict[str, int] = {}
+        for item in initial:
+            self.add(item)
+
+    def add(self, key: str) -> None:
+        if key not in self.map:
+            self.map[key] = len(self.items)
+            self.items.append(key)
+
+    def discard(self, key: str) -> None:
+        if key in self.map:
+            i = self.map[key]
+            del self.items[i]
+            del self.map[key]
+            for k, v in self.map.items():
+                if v >= i:
+                    self.map[k] = v - 1
+
+    def union(self, other: "ListOrderedSet") -> "ListOrderedSet":
+        return ListOrderedSet(list(self.items) + list(other.items))
+
+    def difference(self, other: List[str]) -> "ListOrderedSet":
+        exclude = set(other)
+        return ListOrderedSet([item for item in self.items if item not in exclude])
+
+def copying(group: List[str], names: List[str]) -> None:
+    functions = ListOrderedSet(group)
+    for name in names:
+        referenced = ListOrderedSet()
+        referenced = referenced.union(functions)
+        referenced = referenced.difference([name])
+
+def in_place(group: List[str], names: List[str]) -> None:
+    functions = OrderedSet(group)
+    for name in names:
+        referenced: OrderedSet[str] = OrderedSet()
+        referenced.update(functions)
+        referenced.discard(name)
+
+def removals(factory: Callable[[List[str]], object], group: List[str]) -> float:
+    items = factory(group)
+    start = time.perf_counter()
+    for name in group[::2]:
+        items.discard(name) # type: ignore
+    return time.perf_counter() - start
+
+def main() -> None:
+    group = [f"function_{i}" for i in range(10000)]
+    names = group[::100]
+
+    discard_before = removals(ListOrderedSet, group)
+    discard_after = removals(OrderedSet, group)
+    print(f"discard half of {len(group)} elements:")
+    print(f"  list-backed: {discard_before:8.3f}s")
+    print(f"  dict-backed: {discard_after:8.3f}s ({discard_before / discard_after:.0f}x)")
+
+    start = time.perf_counter()
+    copying(group, names)
+    before = time.perf_counter() - start
+    start = time.perf_counter()
+    in_place(group, names)
+    after = time.perf_counter() - start
+    print(f"SEE ALSO for {len(names)} pages of a {len(group)} function group:")
+    print(f"  union/difference:         {before:8.3f}s")
+    print(f"  update/discard in place:  {after:8.3f}s ({before / after:.0f}x)")
+
+if __name__ == "__main__":
+    main()
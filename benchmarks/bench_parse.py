@@ -0,0 +1,75 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures the time spent parsing XML during a full run.
+# The previous implementation parsed every XML file twice (once to discover symbols
+# and once to render them); this benchmark compares against that baseline.
+#
+# Run from the repository root with: python -m benchmarks.bench_parse
+
+from typing import Any, List
+
+import lxml.etree
+import glob
+import os
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+def run(xml_dir: str, output_dir: str, cache_size: int) -> List[float]:
+    timings: List[float] = []
+    original = lxml.etree.parse
+
+    def timed_parse(*parameters: Any, **kwargs: Any) -> Any:
+        start = time.perf_counter()
+        tree = original(*parameters, **kwargs)
+        timings.append(time.perf_counter() - start)
+        return tree
+
+    session = manos.Session(manos.Arguments())
+    session.args.output = output_dir
+    session.args.xml_cache_size = cache_size
+    lxml.etree.parse = timed_parse # type: ignore
+    try:
+        assert manos.process_xml(session, xml_dir) == 0
+    finally:
+        lxml.etree.parse = original
+    return timings
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=200, functions=20)
+        output_dir = os.path.join(directory, "man")
+        os.mkdir(output_dir)
+        xml_files = glob.glob(os.path.join(xml_dir, "*.xml"))
+
+        # Baseline: every file parsed twice.
+        start = time.perf_counter()
+        for _ in range(2):
+            for file in xml_files:
+                lxml.etree.parse(file)
+        baseline = time.perf_counter() - start
+        print(f"{len(xml_files)} XML files")
+        print(f"baseline (two passes): {2 * len(xml_files):5} parses {baseline:8.3f}s")
+
+        for cache_size in [0, 64, len(xml_files)]:
+            timings = run(xml_dir, output_dir, cache_size)
+            total = sum(timings)
+            print(f"xml_cache_size={cache_size:<5}: {len(timings):5} parses {total:8.3f}s ({total / baseline:.0%} of baseline)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures the time to stringify the DESCRIPTION of a header declaring 2,000 symbols.
+# The baseline is the previous implementation of Roff.__str__ which built its result
+# with repeated string concatenation.
+#
+# Run from the repository root with: python -m benchmarks.bench_roff
+
+from typing import Callable, List, Optional
+
+import time
+
+import manos.__main__ as manos
+from .synthetic import Project
+
+SYMBOLS = 2000
+
+# The previous implementation of Roff.__str__, kept verbatim for comparison.
+def concatenate(roff: manos.Roff) -> str:
+    entries: List[manos.RoffElements] = []
+    textblob = ""
+    for curr in roff.filter():
+        if isinstance(curr, manos.Text):
+            textblob += curr.content
+        else:
+            if len(textblob) > 0:
+                entries.append(manos.Text(textblob))
+                textblob = ""
+            entries.append(curr)
+    if len(textblob) > 0:
+        entries.append(manos.Text(textblob))
+    text = ""
+    prev: Optional[manos.RoffElements] = None
+    for curr in entries:
+        if isinstance(curr, manos.Macro):
+            if len(text) > 0:
+                text += "\n"
+            text += curr.name
+        elif isinstance(curr, manos.CodeLine):
+            if isinstance(prev, manos.Macro):
+                text += "\n"
+            elif isinstance(prev, manos.CodeLine):
+                text += "\n"
+            text += curr.source
+        elif isinstance(curr, manos.Text):
+            if isinstance(prev, manos.Macro) or isinstance(prev, manos.CodeLine):
+                text += "\n"
+            text += "\n".join(manos.segment(curr.content))
+        prev = curr
+    return text
+
+# Mimic the DESCRIPTION of parse_header(): every symbol gets a subsection heading,
+# a signature, and paragraphs made of many small text fragments.
+def header_description(project: Project) -> manos.Roff:
+    roff = manos.Roff()
+    for index in range(SYMBOLS):
+        roff.append_macro(".SS")
+        roff.append_text(f"symbol_{index}")
+        roff.append_macro(".PP")
+        roff.append_source(f"int symbol_{index}(int x);")
+        for _ in range(project.random.randint(1, 3)):
+            roff.append_macro(".PP")
+            for _ in range(project.random.randint(2, 8)):
+                roff.append_text(project.sentence())
+                roff.append_text(r"\fB")
+                roff.append_text(project.random.choice(["value", "pointer", "buffer"]))
+                roff.append_text(r"\fR ")
+    return roff
+
+def measure(function: Callable[[manos.Roff], str], roff: manos.Roff, repeat: int) -> float:
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        function(roff)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+def main() -> None:
+    roff = header_description(Project(1))
+    assert concatenate(roff) == str(roff)
+    print(f"{SYMBOLS} symbols, {len(roff)} roff entries")
+    baseline = measure(concatenate, roff, 5)
+    buffered = measure(manos.Roff.__str__, roff, 5)
+    print(f"concatenation: {baseline:8.3f}s")
+    print(f"buffered:      {buffered:8.3f}s ({buffered / baseline:.0%} of baseline)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures sentence segmentation throughput in sentences per second.
+# The baseline is the previous implementation which rebuilt the list of suppressions
+# on every call and checked each of them against every segment.
+#
+# Run from the repository root with: python -m benchmarks.bench_segment
+
+from typing import Callable, List
+
+import re
+import time
+
+from manos.sentence import SUPPRESSIONS, segment
+from .synthetic import Project
+
+# The previous implementation of segment(), kept for comparison.
+def linear_segment(text: str) -> List[str]:
+    def suppress(segment: str) -> bool:
+        segment = segment.rstrip()
+        suppressions = list(SUPPRESSIONS) # The list literal was rebuilt on every call.
+        for sup in suppressions:
+            if segment.endswith(sup):
+                return True
+        return False
+
+    sentences: List[str] = []
+    split = re.split(r"([\.\!\?]+['\"]*\s+)", text)
+    prefix = ""
+    while len(split) > 0:
+        segment = split.pop(0)
+        if len(split) > 0:
+            segment += split.pop(0)
+        if suppress(segment):
+            prefix += segment
+            continue
+        if len(segment) > 0:
+            sentences.append(prefix + segment)
+            prefix = ""
+    if len(prefix) > 0:
+        sentences.append(prefix)
+    return [s.strip() for s in sentences]
+
+def measure(function: Callable[[str], List[str]], paragraphs: List[str]) -> float:
+    start = time.perf_counter()
+    for paragraph in paragraphs:
+        function(paragraph)
+    return time.perf_counter() - start
+
+def main() -> None:
+    project = Project(1)
+    # Paragraphs of a few sentences, like the text blobs coalesced by Roff.__str__,
+    # plus a few very long ones like the DESCRIPTION of a large header.
+    paragraphs = ["".join(project.sentence() for _ in range(project.random.randint(1, 6))) for _ in range(20000)]
+    paragraphs += ["".join(project.sentence() for _ in range(2000)) for _ in range(5)]
+    sentences = sum(len(segment(paragraph)) for paragraph in paragraphs)
+    for paragraph in paragraphs:
+        assert segment(paragraph) == linear_segment(paragraph)
+    baseline = measure(linear_segment, paragraphs)
+    trie = measure(segment, paragraphs)
+    print(f"{len(paragraphs)} paragraphs, {sentences} sentences")
+    print(f"linear scan:   {sentences / baseline:10.0f} sentences/s")
+    print(f"suffix trie:   {sentences / trie:10.0f} sentences/s ({baseline / trie:.1f}x)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,92 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures the cost of rendering heavily styled documentation with lazy inline spans.
+# The baseline registers handlers that serialize styled text eagerly, like the previous
+# implementation, so nested styling segments the same text once per nesting level.
+#
+# Run from the repository root with: python -m benchmarks.bench_spans
+
+from typing import Dict, List, Tuple
+
+import time
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import Project
+
+def eager(prefix: str) -> manos.Handler:
+    def handler(ctx: manos.Context, elem: lxml.etree._Element) -> manos.Visit:
+        content = yield elem
+        roff = manos.Roff()
+        roff.append_text(f"{prefix}{content}\\f[R]")
+        return roff
+    return handler
+
+# Paragraphs where most words are styled, some with nested styles.
+def styled_paragraphs(project: Project, count: int) -> List[lxml.etree._Element]:
+    paragraphs: List[lxml.etree._Element] = []
+    for _ in range(count):
+        words: List[str] = []
+        for word in project.sentence().split():
+            style = project.random.randint(0, 4)
+            if style == 0:
+                word = f"<bold>{word}</bold>"
+            elif style == 1:
+                word = f"<emphasis><bold>{word}</bold></emphasis>"
+            elif style == 2:
+                word = f"<bold><emphasis><bold>{word}</bold></emphasis></bold>"
+            elif style == 3:
+                word = f"<computeroutput>{word}</computeroutput>"
+            words.append(word)
+        paragraphs.append(lxml.etree.fromstring(f"<para>{' '.join(words)}</para>"))
+    return paragraphs
+
+def render(session: manos.Session, paragraphs: List[lxml.etree._Element]) -> Tuple[List[str], float, int]:
+    calls = 0
+    original = manos.segment
+    def counted(text: str) -> List[str]:
+        nonlocal calls
+        calls += 1
+        return original(text)
+    manos.segment = counted
+    try:
+        start = time.perf_counter()
+        output = [str(manos.process_as_roff(manos.Context(session), paragraph)) for paragraph in paragraphs]
+        elapsed = time.perf_counter() - start
+    finally:
+        manos.segment = original
+    return output, elapsed, calls
+
+def main() -> None:
+    session = manos.Session(manos.Arguments())
+    paragraphs = styled_paragraphs(Project(1), 20000)
+
+    lazy, lazy_time, lazy_calls = render(session, paragraphs)
+    handlers: Dict[str, manos.Handler] = dict(manos.HANDLERS)
+    manos.register_handler("bold", eager("\\f[B]"))
+    manos.register_handler("emphasis", eager("\\f[I]"))
+    try:
+        baseline, baseline_time, baseline_calls = render(session, paragraphs)
+    finally:
+        manos.HANDLERS.update(handlers)
+    assert lazy == baseline
+
+    print(f"{len(paragraphs)} paragraphs")
+    print(f"eager: {baseline_time:7.3f}s, {baseline_calls:7} segment() calls")
+    print(f"spans: {lazy_time:7.3f}s, {lazy_calls:7} segment() calls ({lazy_time / baseline_time:.0%} of baseline)")
+
+if __name__ == "__main__":
+    main()
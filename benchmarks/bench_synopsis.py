@@ -0,0 +1,81 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+# Measures rendering function-heavy headers when the brief description and signature of each
+# function are shared by the header's man page and the function's man page.
+# The baseline renders the function pages without the synopses recorded by the header page,
+# like the previous implementation, so every brief and signature is rendered twice.
+#
+# Run from the repository root with: python -m benchmarks.bench_synopsis
+
+from typing import Callable, List
+
+import glob
+import os
+import tempfile
+import time
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import generate
+
+# The previous implementation of parse_xml(), kept for comparison.
+def unshared(session: manos.Session, tree: lxml.etree._ElementTree) -> List[manos.Page]:
+    element = tree.getroot().find("compounddef")
+    assert element is not None
+    header_display_name = manos.process_text(element.find("compoundname"))
+    pages = [manos.parse_header(session, element, {})]
+    for sectiondef in element.findall("sectiondef"):
+        if sectiondef.get("kind") == "func":
+            for memberdef in sectiondef.findall("memberdef"):
+                pages.append(manos.parse_function(session, memberdef, header_display_name))
+    return pages
+
+def measure(function: Callable[[manos.Session, lxml.etree._ElementTree], List[manos.Page]], session: manos.Session, headers: List[lxml.etree._ElementTree]) -> float:
+    best = float("inf")
+    for _ in range(3):
+        start = time.perf_counter()
+        for tree in headers:
+            function(session, tree)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        # Function-heavy headers with short descriptions, so briefs and signatures dominate.
+        xml_dir = generate(directory, headers=20, functions=100, blocks=1)
+        session = manos.Session(manos.Arguments())
+        headers: List[lxml.etree._ElementTree] = []
+        for file in sorted(glob.glob(os.path.join(xml_dir, "*.xml"))):
+            tree = lxml.etree.parse(file)
+            if manos.preparse_xml(session, tree):
+                headers.append(tree)
+        manos.link_groups(session)
+        manos.link_references(session)
+        pages = 0
+        for tree in headers:
+            rendered = manos.parse_xml(session, tree)
+            assert rendered == unshared(session, tree)
+            pages += len(rendered)
+
+        baseline = measure(unshared, session, headers)
+        shared = measure(manos.parse_xml, session, headers)
+        print(f"{len(headers)} headers, {pages} pages")
+        print(f"rendered twice: {baseline:7.3f}s")
+        print(f"shared:         {shared:7.3f}s ({shared / baseline:.0%} of baseline)")
+
+if __name__ == "__main__":
+    main()
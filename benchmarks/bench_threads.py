@@ -0,0 +1,61 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Compares rendering with worker processes (--jobs) against rendering with threads (--jobs --threads).
+# Threads only scale on a free-threaded build of Python, e.g. python3.13t; with the GIL enabled
+# they measure the overhead of the thread backend instead.
+# The output of every run is compared against the serial run to confirm it is byte-identical.
+#
+# Run from the repository root with: python -m benchmarks.bench_threads
+
+import filecmp
+import os
+import sys
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+def run(xml_dir: str, output_dir: str, jobs: int, threads: bool) -> float:
+    os.makedirs(output_dir)
+    session = manos.Session(manos.Arguments())
+    session.args.output = output_dir
+    session.args.jobs = jobs
+    session.args.threads = threads
+    start = time.perf_counter()
+    assert manos.process_xml(session, xml_dir) == 0
+    return time.perf_counter() - start
+
+def main() -> None:
+    gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(f"Python {sys.version.split()[0]}, GIL {'enabled' if gil else 'disabled'}")
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=200, functions=20)
+        serial_dir = os.path.join(directory, "serial")
+        serial = run(xml_dir, serial_dir, 1, False)
+        print(f"serial:     {serial:7.3f}s")
+        for jobs in [2, 4, 8]:
+            timings = []
+            for threads in [False, True]:
+                output_dir = os.path.join(directory, f"man{jobs}-{threads}")
+                timings.append(run(xml_dir, output_dir, jobs, threads))
+                mismatches = filecmp.dircmp(serial_dir, output_dir).diff_files
+                assert len(mismatches) == 0, f"output differs from serial run: {mismatches}"
+            processes, threads = timings
+            print(f"jobs={jobs}: processes {processes:7.3f}s ({serial / processes:.2f}x), threads {threads:7.3f}s ({serial / threads:.2f}x)")
+
+if __name__ == "__main__":
+    main()
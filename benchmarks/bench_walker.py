@@ -0,0 +1,91 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures the per-node cost of converting XML to Roff with the explicit-stack walker.
+# The baseline drives the same handlers with recursion, one Python call frame per
+# nesting level, like the previous implementation.
+#
+# Run from the repository root with: python -m benchmarks.bench_walker
+
+from typing import Callable, List, Optional
+
+import glob
+import os
+import tempfile
+import time
+
+import lxml.etree
+import manos.__main__ as manos
+from .synthetic import generate
+
+def recursive_children(ctx: manos.Context, elem: lxml.etree._Element) -> manos.Roff:
+    content = manos.Roff()
+    if elem.text:
+        content.append_text(elem.text)
+    for child in elem:
+        content.append_roff(recursive_as_roff(ctx, child))
+        if child.tail:
+            content.append_text(child.tail)
+    return content
+
+def recursive_as_roff(ctx: manos.Context, elem: Optional[lxml.etree._Element]) -> manos.Roff:
+    if elem is None:
+        return manos.Roff()
+    handled = manos.dispatch(ctx, elem)
+    if isinstance(handled, manos.Roff):
+        return handled
+    result: Optional[manos.Roff] = None
+    try:
+        while True:
+            request = handled.send(result) # type: ignore
+            if isinstance(request, tuple):
+                # The handler asked for the children to be appended to one of its buffers.
+                elem, content = request
+                content.append_roff(recursive_children(ctx, elem))
+                result = content
+            else:
+                result = recursive_children(ctx, request)
+    except StopIteration as stop:
+        return stop.value # type: ignore
+
+def measure(function: Callable[[manos.Context, lxml.etree._Element], manos.Roff], session: manos.Session, descriptions: List[lxml.etree._Element]) -> float:
+    best = float("inf")
+    for _ in range(3):
+        start = time.perf_counter()
+        for description in descriptions:
+            function(manos.Context(session), description)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=20, functions=20, blocks=6)
+        session = manos.Session(manos.Arguments())
+        trees = [lxml.etree.parse(file) for file in glob.glob(os.path.join(xml_dir, "*.xml"))]
+        for tree in trees:
+            manos.preparse_xml(session, tree)
+        manos.link_references(session)
+        descriptions = [elem for tree in trees for elem in tree.iter("detaileddescription")]
+        nodes = sum(1 for description in descriptions for _ in description.iter())
+        for description in descriptions:
+            assert str(recursive_as_roff(manos.Context(session), description)) == str(manos.process_as_roff(manos.Context(session), description))
+
+        print(f"{len(descriptions)} descriptions, {nodes} nodes")
+        for name, function in [("recursive", recursive_as_roff), ("explicit stack", manos.process_as_roff)]:
+            elapsed = measure(function, session, descriptions)
+            print(f"{name:<15}: {elapsed:7.3f}s, {elapsed / nodes * 1e6:6.2f} us/node")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Measures how much of the time spent writing man pages is hidden behind rendering by the writer thread.
+# The filesystem is throttled by delaying every page written, like the round trips of a network
+# filesystem; the delay releases the GIL just like blocking I/O does.
+# The output of every run is compared against the synchronous run to confirm it is byte-identical.
+#
+# Run from the repository root with: python -m benchmarks.bench_writer
+
+import filecmp
+import io
+import os
+import tempfile
+import time
+
+import manos.__main__ as manos
+from .synthetic import generate
+
+LATENCY = 0.002 # Seconds added to every page written.
+
+def throttled(args: manos.Arguments, page: manos.Page) -> bool:
+    time.sleep(LATENCY)
+    return original(args, page)
+
+original = manos.write_page
+
+def run(xml_dir: str, output_dir: str, depth: int) -> float:
+    os.makedirs(output_dir)
+    session = manos.Session(manos.Arguments())
+    session.args.output = output_dir
+    session.args.write_queue = depth
+    session.args.stdout = io.StringIO()
+    start = time.perf_counter()
+    assert manos.process_xml(session, xml_dir) == 0
+    return time.perf_counter() - start
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as directory:
+        xml_dir = generate(directory, headers=100, functions=20)
+        manos.write_page = throttled
+        try:
+            timings = {}
+            for depth in [0, 1, 16, 64]:
+                output_dir = os.path.join(directory, f"man{depth}")
+                timings[depth] = run(xml_dir, output_dir, depth)
+                mismatches = filecmp.dircmp(os.path.join(directory, "man0"), output_dir).diff_files
+                assert len(mismatches) == 0, f"output differs from synchronous run: {mismatches}"
+        finally:
+            manos.write_page = original
+        pages = len(os.listdir(os.path.join(directory, "man0")))
+        print(f"{pages} pages, {LATENCY * 1000:.0f} ms per page written ({pages * LATENCY:.3f}s in total)")
+        for depth, elapsed in timings.items():
+            print(f"write queue {depth:2}: {elapsed:7.3f}s ({timings[0] / elapsed:.2f}x)")
+
+if __name__ == "__main__":
+    main()
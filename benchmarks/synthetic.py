@@ -0,0 +1,157 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Generates a synthetic Doxygen XML directory for benchmarking.
+# The output mimics what Doxygen writes for a C project: one XML file per header,
+# one per struct or union, one per group, an example, and "doxyfile.xml".
+# Benchmarks use this so they run without Doxygen or a real C project.
+
+from typing import List, Tuple
+
+import os
+import random
+
+WORDS = ["alpha", "beta", "gamma", "delta", "Mr.", "Smith", "e.g.", "the", "U.S.A.",
+         "value", "pointer", "buffer", "length", "returns", "frobs", "doodad"]
+
+class Project:
+    def __init__(self, seed: int) -> None:
+        self.random = random.Random(seed)
+        self.functions: List[Tuple[str, str]] = []
+        self.structs: List[Tuple[str, str]] = []
+
+    def sentence(self) -> str:
+        text = " ".join(self.random.choice(WORDS) for _ in range(self.random.randint(4, 12)))
+        return text[0].upper() + text[1:] + self.random.choice([". ", "! ", "? "])
+
+    def inline(self, params: List[str]) -> str:
+        kind = self.random.randint(0, 9)
+        if kind == 0 and len(params) > 0:
+            return f"<computeroutput>{self.random.choice(params)}</computeroutput> "
+        if kind == 1:
+            return f"<bold>{self.sentence()}</bold>"
+        if kind == 2:
+            return f"<emphasis><bold>{self.sentence()}</bold> {self.sentence()}</emphasis>"
+        if kind == 3 and len(self.functions) > 0:
+            id, name = self.random.choice(self.functions)
+            return f'see <ref refid="{id}" kindref="member">{name}</ref> '
+        if kind == 4 and len(self.structs) > 0:
+            id, name = self.random.choice(self.structs)
+            return f'the <ref refid="{id}" kindref="compound">{name}</ref> '
+        return self.sentence()
+
+    def para(self, params: List[str]) -> str:
+        return "<para>" + "".join(self.inline(params) for _ in range(self.random.randint(1, 4))) + "</para>"
+
+    def block(self, params: List[str]) -> str:
+        kind = self.random.randint(0, 5)
+        if kind == 0:
+            items = "".join(f"<listitem>{self.para(params)}</listitem>" for _ in range(self.random.randint(2, 6)))
+            return f"<para><itemizedlist>{items}</itemizedlist></para>"
+        if kind == 1:
+            line = '<codeline><highlight class="normal">int<sp/>x<sp/>=<sp/>0;</highlight></codeline>'
+            return f"<para><programlisting>{line * 3}</programlisting></para>"
+        return self.para(params)
+
+    def detailed(self, params: List[str], blocks: int) -> str:
+        xml = "".join(self.block(params) for _ in range(blocks))
+        if len(params) > 0:
+            items = "".join("<parameteritem><parameternamelist>"
+                            f"<parametername>{p}</parametername></parameternamelist>"
+                            f"<parameterdescription>{self.para(params)}</parameterdescription>"
+                            "</parameteritem>" for p in params)
+            xml += f'<para><parameterlist kind="param">{items}</parameterlist>'
+            xml += f'<simplesect kind="return"><para>{self.sentence()}</para></simplesect></para>'
+        return f"<detaileddescription>{xml}</detaileddescription>"
+
+    def brief(self) -> str:
+        return f"<briefdescription><para>{self.sentence()}</para></briefdescription>"
+
+def write(path: str, body: str) -> None:
+    with open(path, "w", encoding="utf-8") as fp:
+        fp.write(f'<?xml version="1.0" encoding="UTF-8"?>\n<doxygen version="1.9.8">\n{body}\n</doxygen>\n')
+
+# Write the synthetic project to "directory/xml" and return the path to the XML directory.
+# Every header gets one struct, one enum, one typedef, one macro, and 'functions' functions.
+# Every third function belongs to a Doxygen group so the SEE ALSO logic is exercised.
+def generate(directory: str, headers: int = 100, functions: int = 20, blocks: int = 3, seed: int = 1) -> str:
+    project = Project(seed)
+    xml_dir = os.path.join(directory, "xml")
+    os.makedirs(xml_dir, exist_ok=True)
+
+    with open(os.path.join(xml_dir, "doxyfile.xml"), "w", encoding="utf-8") as fp:
+        fp.write('<?xml version="1.0" encoding="UTF-8"?>\n<doxyfile version="1.9.8">\n'
+                 '<option id="PROJECT_NAME" default="no" type="string"><value>"Synthetic"</value></option>\n'
+                 '<option id="PROJECT_BRIEF" default="no" type="string"><value>Synthetic library (libsyn, -lsyn)</value></option>\n'
+                 '<option id="PROJECT_NUMBER" default="no" type="string"><value>1.0.0</value></option>\n'
+                 '</doxyfile>\n')
+
+    # Register symbols up front so descriptions can cross-reference them.
+    groups: List[List[Tuple[str, str]]] = [[] for _ in range(max(1, headers // 10))]
+    for h in range(headers):
+        project.structs.append((f"structs{h}", f"s{h}"))
+        for f in range(functions):
+            name = f"h{h}_f{f}"
+            if f % 3 == 0:
+                group = f"group__g{h % len(groups)}"
+                id = f"{group}_1a{h}x{f}"
+                groups[h % len(groups)].append((id, name))
+            else:
+                id = f"h{h}_8h_1a{f}"
+            project.functions.append((id, name))
+
+    for h in range(headers):
+        struct_id, struct_name = project.structs[h]
+        members = ""
+        for id, name in project.functions[h * functions:(h + 1) * functions]:
+            params = [f"p{i}" for i in range(project.random.randint(0, 3))]
+            signature = "".join(f"<param><type>int</type><declname>{p}</declname></param>" for p in params)
+            members += (f'<memberdef kind="function" id="{id}" prot="public" static="no">'
+                        f"<type>int</type><argsstring>()</argsstring><name>{name}</name>{signature}"
+                        f"{project.brief()}{project.detailed(params, blocks)}"
+                        f'<location file="include/h{h}.h"/></memberdef>\n')
+        body = (f'<compounddef id="h{h}_8h" kind="file" language="C++">'
+                f"<compoundname>h{h}.h</compoundname>\n"
+                f'<innerclass refid="{struct_id}" prot="public">{struct_name}</innerclass>\n'
+                f'<sectiondef kind="typedef"><memberdef kind="typedef" id="h{h}_8h_1t">'
+                f'<type>struct <ref refid="{struct_id}">{struct_name}</ref> *</type><name>t{h}</name>'
+                f"{project.brief()}{project.detailed([], 1)}</memberdef></sectiondef>\n"
+                f'<sectiondef kind="enum"><memberdef kind="enum" id="h{h}_8h_1e"><name>e{h}</name>'
+                + "".join(f'<enumvalue id="h{h}_8h_1ev{i}"><name>E{h}_{i}</name>{project.brief()}</enumvalue>' for i in range(3))
+                + f"{project.brief()}{project.detailed([], 1)}</memberdef></sectiondef>\n"
+                f'<sectiondef kind="define"><memberdef kind="define" id="h{h}_8h_1d"><name>D{h}</name>'
+                f"<param><defname>a</defname></param>{project.brief()}{project.detailed(['a'], 1)}</memberdef></sectiondef>\n"
+                f'<sectiondef kind="func">{members}</sectiondef>\n'
+                f"{project.brief()}{project.detailed([], blocks)}"
+                f'<location file="include/h{h}.h"/></compounddef>')
+        write(os.path.join(xml_dir, f"h{h}_8h.xml"), body)
+
+        fields = "".join(f'<memberdef kind="variable" id="{struct_id}_1f{i}"><type>int</type>'
+                         f"<name>f{i}</name><argsstring></argsstring>{project.brief()}"
+                         f"{project.detailed([], 1)}</memberdef>" for i in range(4))
+        write(os.path.join(xml_dir, f"{struct_id}.xml"),
+              f'<compounddef id="{struct_id}" kind="struct" language="C++"><compoundname>{struct_name}</compoundname>'
+              f'<sectiondef kind="public-attrib">{fields}</sectiondef>{project.brief()}{project.detailed([], 1)}</compounddef>')
+
+    for index, members in enumerate(groups):
+        body = "".join(f'<memberdef kind="function" id="{id}"><name>{name}</name></memberdef>' for id, name in members)
+        write(os.path.join(xml_dir, f"group__g{index}.xml"),
+              f'<compounddef id="group__g{index}" kind="group"><compoundname>g{index}</compoundname>'
+              f'<sectiondef kind="func">{body}</sectiondef></compounddef>')
+
+    write(os.path.join(xml_dir, "example_8c-example.xml"),
+          f'<compounddef id="example_8c-example" kind="example"><compoundname>example.c</compoundname>'
+          f'{project.detailed([], 2)}<location file="include/h0.h"/></compounddef>')
+    return xml_dir
@@ -1,16 +1,22 @@
 """Manos is a man page generator for C projects using Doxygen.
 
-See the documentation for the 'process' function for details.
+See the documentation for the 'process' and 'generate' functions for details.
 """
 
 __all__ = [
     "process",
+    "generate",
+    "register_handler",
 ]
 
-from typing import List, Set, Tuple, TextIO, Optional
+from typing import Any, Dict, Iterator, List, Set, Tuple, TextIO, Optional, TYPE_CHECKING
+import inspect
 import sys
 
-def process(doxyfile: str,
+if TYPE_CHECKING:
+    from .__main__ import Arguments, Handler
+
+def process(doxyfile: Optional[str] = None,
             output_dir: str = "man",
             section: int = 3,
             include_path: str = "short",
@@ -26,13 +32,32 @@ def process(doxyfile: str,
             function_parameters: bool = False,
             macro_parameters: bool = False,
             composite_fields: bool = False,
+            see_also_limit: Optional[int] = None,
+            streaming: bool = False,
+            low_memory: bool = False,
+            jobs: int = 1,
+            threads: bool = False,
+            write_queue: int = 16,
+            compress: Optional[str] = None,
+            compress_level: Optional[int] = None,
+            load_threads: int = 1,
+            xml_cache_size: Optional[int] = 64,
+            incremental: bool = False,
+            force: bool = False,
+            xml_dir: Optional[str] = None,
+            stats: bool = False,
             stdout: Optional[TextIO] = None,
             stderr: Optional[TextIO] = None,
             doxygen_settings: List[Tuple[str,str]] = []) -> int:
     """
     Generate man page(s) from a Doxygen configuration file specified by `doxyfile``.
+    Alternatively, generate them from the XML output of a previous Doxygen run specified by ``xml_dir``.
+    Each call keeps its own state so calls may run concurrently from different threads,
+    provided their Doxygen configuration files are in different directories and they use different output directories.
+    Doxygen is run in the directory of the configuration file, where its temporary copy "Doxyfile.manos"
+    and the "xml" directory are written, so configuration files sharing a directory overwrite each other's files.
 
-    :param doxyfile: Doxygen configuration file.
+    :param doxyfile: Doxygen configuration file; not required when ``xml_dir`` is specified.
     :param output_dir: Directory to write the man pages.
     :param section: Man page section number, must be in the inclusive range 1-9.
     :param include_path: Toggles if header paths include the full path or just the base file name.
@@ -45,10 +70,26 @@ def process(doxyfile: str,
     :param function_parameters: Toggle \\param documentation in a functions man page.
     :param macro_parameters: Toggle \\param documentation when documenting macros.
     :param composite_fields: Toggle documentation for struct and union fields.
+    :param see_also_limit: Maximum number of man pages listed in the SEE ALSO section; unlimited when ``None``.
+    :param streaming: Discover symbols with a streaming XML parser to reduce peak memory usage.
+    :param low_memory: Keep at most one XML file in memory at a time; implies ``streaming``.
+    :param jobs: Number of worker processes used to render header files.
+    :param threads: Render header files with ``jobs`` threads instead of worker processes; ``jobs`` must be greater than one.
+    :param write_queue: Number of rendered man pages that may wait to be written by a background thread; zero writes them while rendering.
+    :param compress: Compress the man pages with one of "gzip", "bz2", or "xz"; its suffix is appended to their file names.
+    :param compress_level: Compression level in the inclusive range 1-9; defaults to 9 for gzip and bz2 and 6 for xz.
+    :param load_threads: Number of threads used to parse XML files.
+    :param xml_cache_size: Number of parsed header files kept in memory between discovering symbols and rendering them; unbounded when ``None``.
+    :param incremental: Only regenerate man pages for header files that changed since the previous run.
+    :param force: Run Doxygen even if the XML it previously generated is up-to-date.
+    :param xml_dir: Directory of XML previously generated by Doxygen; Doxygen is not run when specified and ``doxyfile`` must be omitted.
+    :param stats: Report how many man pages were written, the time spent in each phase of the run, and how often the reference table was used.
     :param stdout: Redirect Doxygen standard output.
     :param stderr: Redirect Doxygen error output.
     :param doxygen_settings: List of tuples where the first element is the Doxygen setting and the second is its value.
-    :return: Zero on success.
+    :return: Zero on success; errors such as invalid arguments are reported to ``stderr`` and return non-zero.
+    :raises OSError: A man page could not be written. With a ``write_queue``, the error is re-raised by ``Writer.close()``
+                     once the background thread stops; the man pages queued after the failure are discarded.
 
     Where ``include_path`` is one of the following:
 
@@ -63,34 +104,91 @@ def process(doxyfile: str,
     * "variables"
     * "typedefs"
     * "macros"
+    """
 
-    This function should **not** raise any exceptions.
+    from .__main__ import main
+    return main(doxyfile, arguments(locals()))
+
+def generate(doxyfile: Optional[str] = None, **options: Any) -> Iterator[Tuple[str, str]]:
     """
+    Generate man page(s) like ``process`` but yield them, as they are rendered, rather than writing them.
+    Each man page is yielded as a ``(name, text)`` tuple where ``name`` is its file name, e.g. "foo.3".
 
-    from .__main__ import Arguments, main
+    :param doxyfile: Doxygen configuration file; not required when ``xml_dir`` is specified.
+    :param options: Keyword arguments of ``process``. The ``output_dir``, ``incremental``, ``stats``, ``write_queue``,
+                    ``compress``, and ``compress_level`` arguments are ignored because they only apply to writing man pages.
+    :return: Iterator over the man pages in the order ``process`` writes them.
+    :raises RuntimeError: The arguments are invalid or Doxygen failed; the error is also reported to ``stderr``.
+    :raises TypeError: An option is not a keyword argument of ``process``.
+    """
+
+    parameters = {name: parameter.default for name, parameter in inspect.signature(process).parameters.items()}
+    for name in options:
+        if name not in parameters or name == "doxyfile":
+            raise TypeError(f"generate() got an unexpected keyword argument '{name}'")
+    parameters.update(options)
+    from .__main__ import generate as generate_pages
+    return generate_pages(doxyfile, arguments(parameters))
+
+# Convert the keyword arguments of process() into the arguments of a run.
+def arguments(options: Dict[str, Any]) -> "Arguments":
+    from .__main__ import Arguments
     args = Arguments()
-    args.output = output_dir
-    args.section = section
-    args.include_path = include_path
-    args.synopsis = synopsis
-    args.pattern = exclusion_pattern
-    args.topic = topic
-    args.footer_middle = footer_middle
-    args.footer_inside = footer_inside
-    args.header_middle = header_middle
-    args.autofill = autofill
-    args.preamble = preamble
-    args.epilogue = epilogue
-    args.function_parameters = function_parameters
-    args.macro_parameters = macro_parameters
-    args.composite_fields = composite_fields
-    args.doxygen_settings = doxygen_settings
-    if stdout is None:
+    args.output = options["output_dir"]
+    args.section = options["section"]
+    args.include_path = options["include_path"]
+    args.synopsis = options["synopsis"]
+    args.pattern = options["exclusion_pattern"]
+    args.topic = options["topic"]
+    args.footer_middle = options["footer_middle"]
+    args.footer_inside = options["footer_inside"]
+    args.header_middle = options["header_middle"]
+    args.autofill = options["autofill"]
+    args.preamble = options["preamble"]
+    args.epilogue = options["epilogue"]
+    args.function_parameters = options["function_parameters"]
+    args.macro_parameters = options["macro_parameters"]
+    args.composite_fields = options["composite_fields"]
+    args.see_also_limit = options["see_also_limit"]
+    args.streaming = options["streaming"]
+    args.low_memory = options["low_memory"]
+    args.jobs = options["jobs"]
+    args.threads = options["threads"]
+    args.write_queue = options["write_queue"]
+    args.compress = options["compress"]
+    args.compress_level = options["compress_level"]
+    args.load_threads = options["load_threads"]
+    args.xml_cache_size = options["xml_cache_size"]
+    args.incremental = options["incremental"]
+    args.force = options["force"]
+    args.xml_dir = options["xml_dir"]
+    args.stats = options["stats"]
+    args.doxygen_settings = options["doxygen_settings"]
+    if options["stdout"] is None:
         args.stdout = sys.stdout
     else:
-        args.stdout = stdout
-    if stderr is None:
+        args.stdout = options["stdout"]
+    if options["stderr"] is None:
         args.stderr = sys.stderr
     else:
-        args.stderr = stderr
-    return main(doxyfile, args)
+        args.stderr = options["stderr"]
+    return args
+
+def register_handler(tag: str, handler: "Handler") -> None:
+    """
+    Register a function that converts Doxygen XML elements named ``tag`` to Roff.
+
+    :param tag: XML element tag name, e.g. "blockquote".
+    :param handler: Function accepting a ``Context`` and an ``lxml.etree._Element`` and returning a ``Roff`` object.
+
+    The handler may also be a generator that yields elements and receives the ``Roff`` of
+    their children in return, e.g. ``content = yield elem``, and returns its ``Roff`` object.
+    Generator handlers are driven iteratively so deeply nested XML cannot exhaust the call stack.
+
+    The handler replaces any existing handler for ``tag``, including those built into Manos.
+    Tags without a handler raise an exception when encountered. Handlers used with more than
+    one job must be picklable, i.e. defined at the top-level of a module.
+    """
+
+    from .__main__ import register_handler as register
+    register(tag, handler)
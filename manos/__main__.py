@@ -13,23 +13,34 @@
 #  You should have received a copy of the GNU General Public License
 #  along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-from typing import List, Set, Dict, Tuple, Union, Optional, TextIO, TypeAlias, cast
-from io import TextIOWrapper
+from typing import List, Set, Dict, Tuple, Union, Optional, Sequence, Iterable, Iterator, Generator, Deque, Callable, TextIO, TypeAlias, cast
 
 import lxml
 import lxml.etree
+import concurrent.futures
+import collections
+import io
 import os
+import queue
 import sys
+import threading
 import subprocess
 import glob
 import shutil
 import argparse
+import bz2
+import gzip
+import lzma
 import math
 import datetime
 import re
+import hashlib
+import json
+import fnmatch
+import time
 
 from .ordered_set import OrderedSet
-from .sentence import segment
+from .sentence import SEPARATORS, segment
 
 class Arguments(argparse.Namespace):
     def __init__(self) -> None:
@@ -56,6 +67,35 @@ class Arguments(argparse.Namespace):
         self.stdout: TextIO = sys.stdout
         self.stderr: TextIO = sys.stderr
         self.doxygen_settings: List[Tuple[str,str]] = []
+        # Maximum number of parsed header trees kept between the discovery and render passes; unbounded when None.
+        # 64 covers the public headers of most libraries while bounding the memory held for larger projects.
+        self.xml_cache_size: Optional[int] = 64
+        self.streaming = False
+        self.low_memory = False
+        self.jobs = 1
+        self.threads = False
+        self.write_queue = 16 # Maximum number of rendered man pages waiting for the writer thread.
+        self.compress: Optional[str] = None
+        self.compress_level: Optional[int] = None
+        self.load_threads = 1
+        self.incremental = False
+        self.force = False
+        self.xml_dir: Optional[str] = None
+        self.see_also_limit: Optional[int] = None
+        self.stats = False
+
+    # The standard streams cannot be pickled.
+    # They are replaced when the arguments are sent to a worker process.
+    def __getstate__(self) -> Dict[str, object]:
+        attributes = self.__dict__.copy()
+        del attributes["stdout"]
+        del attributes["stderr"]
+        return attributes
+
+    def __setstate__(self, attributes: Dict[str, object]) -> None:
+        self.__dict__.update(attributes)
+        self.stdout = sys.stdout
+        self.stderr = sys.stderr
 
     def finish(self) -> None:
         for sublist in self._synopsis:
@@ -71,12 +111,12 @@ class Field:
         self.name = "unnamed"
         self.argstring = ""
         self.brief = ""
-        self.description = Roff()
 
 class CompositeType:
-    def __init__(self, is_struct: bool, name: str, element: lxml.etree._Element) -> None:
+    def __init__(self, is_struct: bool, name: str, element: Optional[lxml.etree._Element], file: Optional[str] = None) -> None:
         self.is_struct = is_struct
-        self.element: Optional[lxml.etree._Element] = element
+        self.element = element
+        self.file = file # In low memory mode the definition is parsed again from this file when it is needed.
         self.name = name
         self.brief = ""
         self.description = Roff()
@@ -113,31 +153,123 @@ class Group:
     def __init__(self, id: str) -> None:
         self.id = id
         self.functions: OrderedSet[str] = OrderedSet()
+        self.see_also: List[str] = [] # Built by link_groups() after discovery.
 
 # Doxygen example XML.
 class Example:
-    def __init__(self, description: lxml.etree._Element) -> None:
-        self.description = description
+    def __init__(self, description: Optional[lxml.etree._Element], file: Optional[str] = None) -> None:
+        self._description = description
+        self.file = file
+
+    # In low memory mode the description is not retained; it is parsed from the example's XML file
+    # each time it is needed, i.e. when the man page of the header it belongs to is rendered.
+    @property
+    def description(self) -> lxml.etree._Element:
+        if self._description is not None:
+            return self._description
+        assert self.file is not None
+        description = lxml.etree.parse(self.file).find("compounddef/detaileddescription")
+        assert description is not None
+        return description
+
+    # XML elements cannot be pickled so they are serialized when sent to a worker process.
+    def __getstate__(self) -> Tuple[Optional[bytes], Optional[str]]:
+        if self._description is None:
+            return None, self.file
+        return lxml.etree.tostring(self._description), None
+
+    def __setstate__(self, state: Tuple[Optional[bytes], Optional[str]]) -> None:
+        description, self.file = state
+        self._description = None if description is None else lxml.etree.fromstring(description)
 
 Compound: TypeAlias = Union[CompositeType, Group, Enum, Function, Typedef, EnumElement, Define]
 
+# Entries are slotted because a man page is made of thousands of them.
 class Text:
+    __slots__ = ("content",)
+
     def __init__(self, content: str) -> None:
         self.content = content
 
+# Inline formatting, like bold text, wrapped around the Roff of an element's children.
+# The children are serialized when the span is first read, which is normally when the
+# enclosing block is serialized, and the result is cached. Spans that are discarded,
+# like those in a \see command, are never serialized.
+class Span(Text):
+    __slots__ = ("prefix", "inner", "suffix", "text")
+
+    def __init__(self, prefix: str, inner: 'Roff', suffix: str) -> None:
+        self.prefix = prefix
+        self.inner = inner
+        self.suffix = suffix
+        self.text: Optional[str] = None
+
+    @property
+    def content(self) -> str:
+        if self.text is None:
+            # Serialize nested spans innermost first so serializing a span never recurses.
+            pending: List[Span] = [self]
+            order: List[Span] = []
+            while len(pending) > 0:
+                span = pending.pop()
+                order.append(span)
+                for entry in span.inner.entries:
+                    if isinstance(entry, Span) and entry.text is None:
+                        pending.append(entry)
+            for span in reversed(order):
+                if span.text is None:
+                    span.text = f"{span.prefix}{span.inner.inline()}{span.suffix}"
+        assert self.text is not None
+        return self.text
+
+    @content.setter
+    def content(self, content: str) -> None:
+        self.text = content
+
 # This is identical to 'Text' except it is output as-is without any special processing.
 # It is intended for literal blocks, like code examples.
 class CodeLine:
+    __slots__ = ("source",)
+
     def __init__(self, source: str) -> None:
         assert source.find("\n") == -1, "code line cannot contain a new line character"
         self.source = source
 
 class Macro:
+    __slots__ = ("name",)
+
     def __init__(self, name: str) -> None:
         self.name = name
 
 RoffElements = Union[Text, Macro, CodeLine]
 
+# A rendered man page: its file name and content.
+Page: TypeAlias = Tuple[str, str]
+
+# The inline text a <ref> to a compound is rendered as. Text entries are never modified after
+# they are created so the same entry is shared by every reference to the compound.
+# If the compound is a function, its name is listed in the SEE ALSO section of the referencing man page.
+class Reference:
+    __slots__ = ("text", "function")
+
+    def __init__(self, text: str, function: Optional[str] = None) -> None:
+        self.text = Text(text)
+        self.function = function
+
+# Timings and counters reported with --stats.
+class Stats:
+    def __init__(self) -> None:
+        self.timings: Dict[str, float] = {}
+        self.reference_hits = 0
+
+    def add_time(self, phase: str, seconds: float) -> None:
+        self.timings[phase] = self.timings.get(phase, 0.0) + seconds
+
+    def report(self, file: TextIO, references: int) -> None:
+        for phase, seconds in self.timings.items():
+            print(f"{phase + ':':<12}{seconds:8.3f}s", file=file)
+        print(f"{references} references rendered ahead of time, {self.reference_hits} uses", file=file)
+
 class State:
     def __init__(self) -> None:
         self.project_name: Optional[str] = None
@@ -145,13 +277,32 @@ class State:
         self.project_version: Optional[str] = None
         self.examples: Dict[str, List[Example]] = {}
         self.compounds: Dict[str, Compound] = {}
-
-state = State()
-args = Arguments()
+        self.references: Dict[str, Reference] = {} # Built by link_references() after discovery.
+
+# Everything a run reads and writes: its arguments, the symbols it discovered, and its statistics.
+# The session is passed explicitly, rather than held globally, so runs in different threads do not interfere.
+class Session:
+    def __init__(self, args: Arguments) -> None:
+        self.args = args
+        self.state = State()
+        self.stats = Stats()
+
+    # A session for rendering on another thread. The discovered symbols are only read while rendering
+    # so they are shared, but the thread captures its warnings and counts its statistics separately.
+    def for_thread(self) -> 'Session':
+        # The arguments are copied without __getstate__(), which drops the standard streams for pickling.
+        args = Arguments.__new__(Arguments)
+        args.__dict__.update(self.args.__dict__)
+        session = Session(args)
+        session.args.stdout = io.StringIO()
+        session.state = self.state
+        return session
 
 class Roff:
-    def __init__(self) -> None:
-        self.entries: List[RoffElements] = []
+    __slots__ = ("entries",)
+
+    def __init__(self, entries: Optional[List[RoffElements]] = None) -> None:
+        self.entries: List[RoffElements] = [] if entries is None else entries
 
     def is_text(self) -> bool:
         for entry in self.entries:
@@ -174,18 +325,17 @@ class Roff:
                     other = r"\[char46]" + other[1:]  # Escape the first dot.
         self.entries.append(Text(other))
 
+    def append_span(self, prefix: str, inner: 'Roff', suffix: str) -> None:
+        self.entries.append(Span(prefix, inner, suffix))
+
     def append_source(self, other: str) -> None:
         self.entries.append(CodeLine(other))
 
     def append_macro(self, other: str) -> None:
-        roff = Roff()
-        roff.entries.append(Macro(other))
-        self.append_roff(roff)
+        self.entries.append(Macro(other))
 
     def copy(self) -> 'Roff':
-        copy = Roff()
-        copy.entries = self.entries.copy()
-        return copy
+        return Roff(self.entries.copy())
 
     def filter(self) -> List[RoffElements]:
         keep: List[RoffElements] = []
@@ -214,9 +364,7 @@ class Roff:
         return keep
     
     def simplify(self) -> 'Roff':
-        copy = self.copy()
-        copy.entries = copy.filter()
-        return copy
+        return Roff(self.filter())
     
     def has_command(self, index: int, command: str) -> bool:
         entry = self.entries[index]
@@ -230,385 +378,517 @@ class Roff:
     def __len__(self) -> int:
         return len(self.entries)
 
+    # Serialize Roff that appears inline, e.g. inside bold text, exactly like __str__() would.
+    # Text without sentence separators is not segmented because segmentation would only strip it.
+    def inline(self) -> str:
+        if self.is_text():
+            text = "".join(entry.content for entry in cast(List[Text], self.entries) if len(entry.content.strip()) > 0)
+            if SEPARATORS.search(text) is None:
+                return text.strip()
+        return str(self)
+
     def __str__(self) -> str:
         # Coalesce neighboring Text blocks into a single text block.
         # This is needed so sentence segmentation is performed on the entire string.
+        # Strings are collected in lists and joined once because repeated concatenation
+        # is quadratic for headers with many symbols.
         entries: List[RoffElements] = []
-        textblob = ""
+        textblob: List[str] = []
         for curr in self.filter():
             if isinstance(curr, Text):
-                textblob += curr.content
+                textblob.append(curr.content)
             else:
                 if len(textblob) > 0:
-                    entries.append(Text(textblob))
-                    textblob = ""
+                    entries.append(Text("".join(textblob)))
+                    textblob = []
                 entries.append(curr)
         if len(textblob) > 0:
-            entries.append(Text(textblob))
+            entries.append(Text("".join(textblob)))
 
         # Concatenate all macros and text blocks.
-        text = ""
+        # Only non-empty strings are added to the buffer so it is empty if, and only if,
+        # the text written so far is empty.
+        buffer: List[str] = []
+        def write(string: str) -> None:
+            if len(string) > 0:
+                buffer.append(string)
         prev: Optional[RoffElements] = None
         for curr in entries:
             # Put roff macros on their own lines.
             if isinstance(curr, Macro):
                 # Add a new line unless were at the beginning of the string.
                 # Thie ensures macros are always on their own line.
-                if len(text) > 0:
-                    text += "\n"
-                text += curr.name
+                if len(buffer) > 0:
+                    write("\n")
+                write(curr.name)
             elif isinstance(curr, CodeLine):
                 # If the previous entry was a macro, then add a new line after it.
                 if isinstance(prev, Macro):
-                    text += "\n"
+                    write("\n")
                 # If the previous entry was code, then append a new line.
                 # This ensures each line of code is seperated onto their own line.
                 elif isinstance(prev, CodeLine):
-                    text += "\n"
-                text += curr.source
+                    write("\n")
+                write(curr.source)
             elif isinstance(curr, Text):
                 # If the previous entry was a macro or source code, then add a new line after it.
                 # This deliminates code/macros from paragraph text.
                 if isinstance(prev, Macro) or isinstance(prev, CodeLine):
-                    text += "\n"
-                text += "\n".join(segment(curr.content))
+                    write("\n")
+                write("\n".join(segment(curr.content)))
             prev = curr
-        return text
+        return "".join(buffer)
 
 class Context:
-    def __init__(self, ignore_refs: bool = False) -> None:
+    def __init__(self, session: Session, ignore_refs: bool = False) -> None:
+        self.session = session
         self.ignore_refs = ignore_refs
         self.referenced_functions: OrderedSet[str] = OrderedSet()
+        self.group_functions: Sequence[str] = ()
+        self.page_name: Optional[str] = None
         self.authors: List[Roff] = []
         self.bugs: List[Roff] = []
         self.examples: List[Roff] = []
         self.deprecated: List[Roff] = []
         self.return_type: Optional[Roff] = None
-        self.function_params: Optional[Roff] = None
+        self.function_params: Optional[Union[Roff, lxml.etree._Element]] = None # See function_parameters().
         self.active_function: Optional[Function] = None
 
     def clear_signature(self) -> None:
         self.return_type = None
         self.function_params = None
 
-def process_children(ctx: Context, elem: lxml.etree._Element) -> Roff:
-    # Compute the text for this node.
-    content = Roff()
-    if elem.text:
-        content.append_text(elem.text)
-    for child in elem:
-        content.append_roff(process_as_roff(ctx, child))
-        if child.tail:
-            content.append_text(child.tail)
-    return content
+# Handlers convert a Doxygen XML element to Roff.
+# A handler either returns the Roff directly or is a generator that yields the elements
+# whose children it needs converted and receives their Roff in return, e.g.
+#
+#     content = yield elem
+#
+# is the equivalent of calling process_children(ctx, elem). A handler can instead yield
+# an element with the Roff to append its children to, e.g.
+#
+#     roff = Roff([Macro(".PP")])
+#     yield elem, roff
+#
+# which avoids building, and then copying, an intermediate Roff for the children.
+# Generator handlers are driven by an explicit stack rather than recursion so the depth
+# of the XML is not limited by the Python call stack.
+Visit: TypeAlias = Generator[Union[lxml.etree._Element, Tuple[lxml.etree._Element, Roff]], Roff, Roff]
+Handler: TypeAlias = Callable[[Context, lxml.etree._Element], Union[Roff, Visit]]
+
+# Element handlers keyed by tag name.
+HANDLERS: Dict[str, Handler] = {}
+
+# Register a handler for elements with the given tag, replacing any existing handler.
+# Downstream users can call this to support Doxygen tags Manos does not handle.
+def register_handler(tag: str, handler: Handler) -> None:
+    HANDLERS[tag] = handler
+
+# Decorator for registering a handler for one or more tags.
+def handles(*tags: str) -> Callable[[Handler], Handler]:
+    def decorator(handler: Handler) -> Handler:
+        for tag in tags:
+            register_handler(tag, handler)
+        return handler
+    return decorator
+
+def dispatch(ctx: Context, elem: lxml.etree._Element) -> Union[Roff, Visit]:
+    handler = HANDLERS.get(elem.tag)
+    if handler is not None:
+        return handler(ctx, elem)
 
-def process_as_roff(ctx: Context, elem: Optional[lxml.etree._Element]) -> Roff:
-    if elem is None:
-        return Roff()
+    # Sections and subsections.
+    # The element tag name has the section depth appended as a number, e.g. <sect1>, <sect2>, etc...
+    if elem.tag.startswith("sect"):
+        return process_section(ctx, elem)
 
-    # Space element.
-    if elem.tag == "sp":
-        roff = Roff()
-        roff.append_text(" ")
-        return roff
+    # Raise an exception for unknown tags so we're alerted
+    # to then and can properly deal with it.
+    raise Exception("unknown node", elem.tag)
 
-    # Bold.
-    if elem.tag == "bold":
-        content = process_children(ctx, elem)
-        roff = Roff()
-        roff.append_text(f"\\f[B]{content}\\f[R]")
-        return roff
+# Stack frame that appends the Roff of an element's text, children, and their tails to a buffer.
+# The buffer is shared with the parent frame when the element has no Roff of its own.
+class ChildrenFrame:
+    __slots__ = ("content", "start", "children", "child")
 
-    # Italic.
-    if elem.tag == "emphasis":
-        content = process_children(ctx, elem)
-        roff = Roff()
-        roff.append_text(f"\\f[I]{content}\\f[R]")
-        return roff
-
-    # Strikethrough
-    if elem.tag == "strike":
-        print("warning: ignoring \\strike command", file=args.stdout)
-        return process_children(ctx, elem)
-
-    # Styling when using inline code experts, i.e. "\c foobar" or "`foobar`" in markdown syntax.
-    if elem.tag == "computeroutput":
-        ctx.ignore_refs = True # Ignore to prevent unwanted styling of recognized types and functions.
-        content = process_children(ctx, elem)
-        ctx.ignore_refs = False
-        if content.is_text():
-            raw_text = str(content)
-            # Doxygen represents function parameters identically to inline code snippets in its generated XML.
-            # To deduce which is which, check if the XML for a function is being processed and if so, then
-            # check if what is being processed matches a function parameter.
-            if ctx.active_function is not None and raw_text in ctx.active_function.params:
-                roff = Roff()
-                roff.append_text(f'\\f[I]{raw_text}\\f[R]')
-                return roff
+    def __init__(self, elem: lxml.etree._Element, content: Optional[Roff] = None) -> None:
+        self.content = Roff() if content is None else content
+        self.start = len(self.content.entries)
+        if elem.text:
+            self.append_text(elem.text)
+        self.children = iter(elem)
+        self.child: Optional[lxml.etree._Element] = None
+
+    # Identical to Roff.append_text() except text is only escaped after macros appended by this frame.
+    # This way the output is the same as if the children were converted into a buffer of their own.
+    def append_text(self, text: str) -> None:
+        entries = self.content.entries
+        if text.startswith(".") and len(entries) > self.start and isinstance(entries[-1], Macro):
+            text = r"\[char46]" + text[1:]  # Escape the first dot.
+        entries.append(Text(text))
+
+# Run the stack machine until the bottom frame completes and return its Roff.
+def walk(ctx: Context, bottom: Union[ChildrenFrame, Visit]) -> Roff:
+    stack: List[Union[ChildrenFrame, Visit]] = [bottom]
+    # The Roff of the frame that completed most recently, if any, to be consumed by the frame beneath it.
+    result: Optional[Roff] = None
+    while True:
+        top = stack[-1]
+        if isinstance(top, ChildrenFrame):
+            if result is not None:
+                assert top.child is not None
+                # Children of transparent elements were appended to this buffer already.
+                if result is not top.content:
+                    top.content.append_roff(result)
+                if top.child.tail:
+                    top.append_text(top.child.tail)
+                result = None
+            top.child = next(top.children, None)
+            if top.child is None:
+                result = top.content
+            elif HANDLERS.get(top.child.tag) is process_transparent:
+                stack.append(ChildrenFrame(top.child, top.content))
+                continue
             else:
-                roff = Roff()
-                roff.append_text(f'\\f[V]{raw_text}\\f[R]')
-                return roff
-        return content
-
-    # Paramter name styling.
-    if elem.tag == "parametername":
-        content = process_children(ctx, elem)
-        roff = Roff()
-        roff.append_text(f"\\f[I]{content}\\f[R]")
-        return roff
-
-    # Paragraph elements: Doxygen likes to wrap <para> elements around everything.
-    # This implementation strips the unneccessary <para> elements when processing the parent element.
-    if elem.tag == "para":
-        roff = Roff()
-        roff.append_macro(".PP")
-        roff.append_roff(process_children(ctx, elem))
-        return roff
-
-    # Special case: paramter list.
-    if elem.tag == "parameterlist":
-        kind = elem.get("kind")
-        if kind == "param":
-            content = Roff()
-            for parameteritem in elem.findall("parameteritem"):
-                params: List[str] = []
-                for parameternamelist in parameteritem.findall("parameternamelist"):
-                    for parametername in parameternamelist.findall("parametername"):
-                        params.append(process_text(parametername))
-                content.append_macro(".TP")
-                content.append_text(", ".join(params) + "\n")
-                content.append_text(process_description(ctx, parameteritem.find("parameterdescription")))
-            ctx.function_params = content
-        elif kind == "retval":
-            content = Roff()
-            for parameteritem in elem.findall("parameteritem"):
-                retvals: List[str] = []
-                for parameternamelist in parameteritem.findall("parameternamelist"):
-                    for parametername in parameternamelist.findall("parametername"):
-                        retvals.append(process_text(parametername))
-                content.append_macro(".TP")
-                content.append_text(", ".join(retvals) + "\n")
-                content.append_text(process_description(ctx, parameteritem.find("parameterdescription")))
-            ctx.return_type = content
-        return Roff()
+                handled = dispatch(ctx, top.child)
+                if isinstance(handled, Roff):
+                    result = handled
+                else:
+                    stack.append(handled)
+                continue
+        else:
+            try:
+                request = top.send(cast(Roff, result))
+                if isinstance(request, tuple):
+                    stack.append(ChildrenFrame(*request))
+                else:
+                    stack.append(ChildrenFrame(request))
+                result = None
+                continue
+            except StopIteration as stop:
+                result = stop.value
+        # The frame on top of the stack completed.
+        stack.pop()
+        if len(stack) == 0:
+            assert result is not None
+            return result
 
-    # Anchor tags are meant to be linked to but have no usage in man pages.
-    if elem.tag == "anchor":
-        return process_children(ctx, elem)
-
-    # Check for internal references, i.e. a reference to a C function or struct.
-    if elem.tag == "ref":
-        # If this is a reference to a C function defined by the API, then emit it
-        # as a man page reference, i.e. the function "foobar" should appear as
-        # the bolded text "foobar (3)" in the man page.
-        content = process_children(ctx, elem)
-        if not ctx.ignore_refs and content.is_text():
-            refid_xml = elem.get("refid")
-            if refid_xml is not None and refid_xml in state.compounds:
-                compound = state.compounds[refid_xml]
-                if isinstance(compound, Function):
-                    roff = Roff()
-                    roff.append_text(f"\\f[B]{compound.name}\\f[R](3)")
-                    ctx.referenced_functions.add(compound.name)
-                    return roff
-                elif isinstance(compound, CompositeType):
-                    roff = Roff()
-                    if compound.is_struct:
-                        roff.append_text(f"\\f[I]struct {compound.name}\\f[R]")
-                    else:
-                        roff.append_text(f"\\f[I]union {compound.name}\\f[R]")
-                    return roff
-                elif isinstance(compound, Enum):
-                    roff = Roff()
-                    roff.append_text(f"\\f[I]enum {compound.name}\\f[R]")
-                    return roff
-                elif isinstance(compound, EnumElement):
-                    roff = Roff()
-                    roff.append_text(f"\\f[I]{compound.name}\\f[R]")
-                    return roff
-                elif isinstance(compound, Typedef):
-                    roff = Roff()
-                    roff.append_text(f"\\f[I]{compound.name}\\f[R]")
-                    return roff
-                elif isinstance(compound, Define):
-                    roff = Roff()
-                    roff.append_text(f"\\f[I]{compound.name}\\f[R]")
-                    return roff
-        return content
-
-    # Check for an external URL link, i.e. a link to a webpage.
-    if elem.tag == "ulink":
-        url = elem.get("url")
-        roff = Roff()
-        roff.append_macro(f".UR {url}")
-        roff.append_roff(process_children(ctx, elem))
-        roff.append_macro(".UE")
-        return roff
+def process_children(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    return walk(ctx, ChildrenFrame(elem))
 
-    # Sections and subsections.
-    # The element tag name has the section depth appended as a number, e.g. <sect1>, <sect2>, etc...
-    if elem.tag.startswith("sect"):
-        section_depth = int(elem.tag[4:])
-        if section_depth > 1:
-            print("warning: flattening subsections", file=args.stdout)
-        title_xml = elem.find("title")
-        assert title_xml is not None
-        title = title_xml.text or ""
-        title = title.capitalize() # Man page sections should be lowercase with the first letter uppercased.
-        roff = Roff()
-        roff.append_macro(f".SS {title}")
-        roff.append_roff(process_children(ctx, elem))
-        return roff
-
-    # Title elements should be extracted manually by their parent element.
-    # Their content should not be emitted here otherwise it will appear
-    # twice in the output.
-    if elem.tag == "title":
+def process_as_roff(ctx: Context, elem: Optional[lxml.etree._Element]) -> Roff:
+    if elem is None:
         return Roff()
-
-    # Ordered and undordered list.
-    if elem.tag in ["orderedlist", "itemizedlist"]:
-        roff = Roff()
-        roff.append_macro(".RS")
-        for index,child in enumerate(elem):
-            assert child.tag == "listitem", "expected <listitem> as child of list"
-            listitem = Roff()
-            if elem.tag == "itemizedlist":
-                listitem.append_macro(".IP \\[bu] 2")
-            else:
-                index += 1
-                indent = int(math.log(index, 10)) + 3
-                listitem.append_macro(f".IP {index}. {indent}")
-            listitem.append_roff(process_children(ctx, child))
-            # Lists should NOT begin with a .PP macro otherwise Roff will begin a new paragraph
-            # which puts the content of the list item on the next line below the bullet point.
-            # Unfortunatly, Doxygen's XML output likes to insert a <para> element as an
-            # immediate child of the <listitem> element; the following check catches
-            # and removes it.
-            if len(listitem) > 2 and listitem.has_command(1, ".PP"):
-                listitem.pop(1)
-            listitem.entries = list(filter(lambda x: not (isinstance(x, Macro) and x.name == ".PP"), listitem.entries)) 
-            roff.append_roff(listitem)
-        roff.append_macro(".RE")
-        return roff
-
-    # Multi-line source code examples.
-    if elem.tag == "programlisting":
-        # Do not style references to types in code examples.
-        # Normally, when something is referenced, like a function, it is emphasized
-        # e.g. the function "foobar" becomes ".BR foober (3)" but for code examples
-        # this behavior should be disabled.
-        ctx.ignore_refs = True
-        roff = Roff()
-        roff.append_macro(".PP")
-        roff.append_macro(".in +4n")
-        roff.append_macro(".EX")
-        for codeline in elem:
-            assert codeline.tag == "codeline", "expected <codeline> element in <programlisting>"
-            text = ""
-            for entry in process_children(ctx, codeline).entries:
-                assert isinstance(entry, Text)
-                text += entry.content
-            roff.append_source(text)
-        roff.append_macro(".EE")
-        roff.append_macro(".in")
-        roff.append_macro(".PP")
-        ctx.ignore_refs = False
-        return roff
-    
-    # The <highlight> elements appears in <programlisting> blocks.
-    # They are used to indicate which keywords are to be highlighted.
-    # Styling isn't applied to code examples in man page output so return their content as-is.
-    if elem.tag == "highlight":
-        return process_children(ctx, elem)
-
-    # The <simplesect> element is used to contain function parameters, return type, and admonitions.
-    if elem.tag == "simplesect":
-        kind = elem.get("kind")
-        if kind == "par":
+    handled = dispatch(ctx, elem)
+    if isinstance(handled, Roff):
+        return handled
+    return walk(ctx, handled)
+
+# Space element.
+@handles("sp")
+def process_space(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    roff = Roff()
+    roff.append_text(" ")
+    return roff
+
+# Bold.
+@handles("bold")
+def process_bold(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    content = yield elem
+    roff = Roff()
+    roff.append_span("\\f[B]", content, "\\f[R]")
+    return roff
+
+# Italic.
+@handles("emphasis")
+def process_emphasis(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    content = yield elem
+    roff = Roff()
+    roff.append_span("\\f[I]", content, "\\f[R]")
+    return roff
+
+# Strikethrough
+@handles("strike")
+def process_strike(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    print("warning: ignoring \\strike command", file=ctx.session.args.stdout)
+    return (yield elem)
+
+# Styling when using inline code experts, i.e. "\c foobar" or "`foobar`" in markdown syntax.
+@handles("computeroutput")
+def process_computeroutput(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    ctx.ignore_refs = True # Ignore to prevent unwanted styling of recognized types and functions.
+    content = yield elem
+    ctx.ignore_refs = False
+    if content.is_text():
+        raw_text = content.inline()
+        # Doxygen represents function parameters identically to inline code snippets in its generated XML.
+        # To deduce which is which, check if the XML for a function is being processed and if so, then
+        # check if what is being processed matches a function parameter.
+        if ctx.active_function is not None and raw_text in ctx.active_function.params:
             roff = Roff()
-            roff.append_roff(process_children(ctx, elem))
+            roff.append_text(f'\\f[I]{raw_text}\\f[R]')
             return roff
-        elif kind == "return":
-            ctx.return_type = process_children(ctx, elem)
-            return Roff()
-        elif kind == "see":
-            # Visit the child elements but discard the Roff result. The purpose
-            # for visiting the children is to check what's being referenced:
-            # If it's a function, then it will be added to the SEE ALSO
-            # section of the man page (see "ref" element handler).
-            process_children(ctx, elem)
-            return Roff()
-        elif kind in ["since", "note", "warning", "attention"]:
-            print("warning: excluding admonition from generated documentation", file=args.stdout)
-            return Roff()
-        elif kind in ["author", "authors"]:
-            ctx.authors.append(process_children(ctx, elem))
-            return Roff()
         else:
-            raise Exception("unknown simplesect kind", kind)
-
-    # Referencable section.
-    if elem.tag == "xrefsect":
-        title_xml = elem.find("xreftitle")
-        if title_xml is not None and title_xml.text is not None:
-            if title_xml.text == "Bug":
-                description_xml = elem.find("xrefdescription")
-                assert description_xml is not None
-                ctx.bugs.append(process_children(ctx, description_xml))
-            elif title_xml.text == "Deprecated":
-                description_xml = elem.find("xrefdescription")
-                assert description_xml is not None
-                ctx.deprecated.append(process_children(ctx, description_xml))
-            else:
-                print("warning: unsupported xrefsect: {0}".format(title_xml.text), file=args.stdout)
+            roff = Roff()
+            roff.append_text(f'\\f[V]{raw_text}\\f[R]')
+            return roff
+    return content
+
+# Paramter name styling.
+@handles("parametername")
+def process_parametername(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    content = yield elem
+    roff = Roff()
+    roff.append_span("\\f[I]", content, "\\f[R]")
+    return roff
+
+# Paragraph elements: Doxygen likes to wrap <para> elements around everything.
+# This implementation strips the unneccessary <para> elements when processing the parent element.
+@handles("para")
+def process_para(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    roff = Roff([Macro(".PP")])
+    yield elem, roff
+    return roff
+
+# Special case: paramter list.
+@handles("parameterlist")
+def process_parameterlist(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    kind = elem.get("kind")
+    if kind == "param":
+        # Parameters are only rendered if they are emitted, which depends on the options. The exception is
+        # parameters whose rendering has side effects, e.g. a \deprecated or \return nested in a \param or a
+        # reference to a function: they are rendered now, in document order, so their sections are written
+        # whether or not the parameters are emitted.
+        if has_side_effects(ctx, elem):
+            ctx.function_params = render_parameters(ctx, elem)
+        else:
+            ctx.function_params = elem
+    elif kind == "retval":
+        content = Roff()
+        for parameteritem in elem.findall("parameteritem"):
+            retvals: List[str] = []
+            for parameternamelist in parameteritem.findall("parameternamelist"):
+                for parametername in parameternamelist.findall("parametername"):
+                    retvals.append(process_text(parametername))
+            content.append_macro(".TP")
+            content.append_text(", ".join(retvals) + "\n")
+            content.append_text(process_description(ctx, parameteritem.find("parameterdescription")))
+        ctx.return_type = content
+    return Roff()
+
+def render_parameters(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    content = Roff()
+    for parameteritem in elem.findall("parameteritem"):
+        params: List[str] = []
+        for parameternamelist in parameteritem.findall("parameternamelist"):
+            for parametername in parameternamelist.findall("parametername"):
+                params.append(process_text(parametername))
+        content.append_macro(".TP")
+        content.append_text(", ".join(params) + "\n")
+        content.append_text(process_description(ctx, parameteritem.find("parameterdescription")))
+    return content
+
+# Returns the Roff of the \param list of the function or macro being rendered, rendering it if it was deferred.
+def function_parameters(ctx: Context) -> Roff:
+    if ctx.function_params is None:
         return Roff()
-    
-    # Move to the next line.
-    if elem.tag == "linebreak":
-        roff = Roff()
-        roff.append_macro(".br")
-        return roff
+    if not isinstance(ctx.function_params, Roff):
+        ctx.function_params = render_parameters(ctx, ctx.function_params)
+    return ctx.function_params
+
+# Whether rendering the element writes to the context: sections such as \return, \author, \bug and \deprecated,
+# nested parameter lists, or references to functions which are listed in the SEE ALSO section.
+def has_side_effects(ctx: Context, elem: lxml.etree._Element) -> bool:
+    for child in elem.iter():
+        if child is not elem and child.tag in ("simplesect", "xrefsect", "parameterlist"):
+            return True
+    for ref in elem.iter("ref"):
+        reference = ctx.session.state.references.get(ref.get("refid", ""))
+        if reference is not None and reference.function is not None:
+            return True
+    return False
+
+# Check for internal references, i.e. a reference to a C function or struct.
+@handles("ref")
+def process_ref(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    # References to compounds defined by the API are rendered ahead of time by link_references(),
+    # e.g. a reference to the function "foobar" appears as the bolded text "foobar (3)" in the man page.
+    content = yield elem
+    if not ctx.ignore_refs and content.is_text():
+        reference = ctx.session.state.references.get(elem.get("refid", ""))
+        if reference is not None:
+            ctx.session.stats.reference_hits += 1
+            if reference.function is not None:
+                ctx.referenced_functions.add(reference.function)
+            return Roff([reference.text])
+    return content
 
-    # Ignore index tags as they're only useful for LaTeX and DocBook formats.
-    # They have no use in man pages so no warning is needed.
-    if elem.tag == "indexentry":
+# Check for an external URL link, i.e. a link to a webpage.
+@handles("ulink")
+def process_ulink(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    url = elem.get("url")
+    roff = Roff([Macro(f".UR {url}")])
+    yield elem, roff
+    roff.append_macro(".UE")
+    return roff
+
+# Sections and subsections, i.e. <sect1>, <sect2>, etc...
+# This handler is not registered by tag because the section depth is part of the tag name.
+def process_section(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    section_depth = int(elem.tag[4:])
+    if section_depth > 1:
+        print("warning: flattening subsections", file=ctx.session.args.stdout)
+    title_xml = elem.find("title")
+    assert title_xml is not None
+    title = title_xml.text or ""
+    title = title.capitalize() # Man page sections should be lowercase with the first letter uppercased.
+    roff = Roff([Macro(f".SS {title}")])
+    yield elem, roff
+    return roff
+
+# Ordered and undordered list.
+@handles("orderedlist", "itemizedlist")
+def process_list(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    roff = Roff()
+    roff.append_macro(".RS")
+    for index,child in enumerate(elem):
+        assert child.tag == "listitem", "expected <listitem> as child of list"
+        listitem = Roff()
+        if elem.tag == "itemizedlist":
+            listitem.append_macro(".IP \\[bu] 2")
+        else:
+            index += 1
+            indent = int(math.log(index, 10)) + 3
+            listitem.append_macro(f".IP {index}. {indent}")
+        yield child, listitem
+        # Lists should NOT begin with a .PP macro otherwise Roff will begin a new paragraph
+        # which puts the content of the list item on the next line below the bullet point.
+        # Unfortunatly, Doxygen's XML output likes to insert a <para> element as an
+        # immediate child of the <listitem> element; the following check catches
+        # and removes it.
+        if len(listitem) > 2 and listitem.has_command(1, ".PP"):
+            listitem.pop(1)
+        listitem.entries = list(filter(lambda x: not (isinstance(x, Macro) and x.name == ".PP"), listitem.entries)) 
+        roff.append_roff(listitem)
+    roff.append_macro(".RE")
+    return roff
+
+# Multi-line source code examples.
+@handles("programlisting")
+def process_programlisting(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    # Do not style references to types in code examples.
+    # Normally, when something is referenced, like a function, it is emphasized
+    # e.g. the function "foobar" becomes ".BR foober (3)" but for code examples
+    # this behavior should be disabled.
+    ctx.ignore_refs = True
+    roff = Roff()
+    roff.append_macro(".PP")
+    roff.append_macro(".in +4n")
+    roff.append_macro(".EX")
+    for codeline in elem:
+        assert codeline.tag == "codeline", "expected <codeline> element in <programlisting>"
+        text = ""
+        for entry in (yield codeline).entries:
+            assert isinstance(entry, Text)
+            text += entry.content
+        roff.append_source(text)
+    roff.append_macro(".EE")
+    roff.append_macro(".in")
+    roff.append_macro(".PP")
+    ctx.ignore_refs = False
+    return roff
+
+# The <simplesect> element is used to contain function parameters, return type, and admonitions.
+@handles("simplesect")
+def process_simplesect(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    kind = elem.get("kind")
+    if kind == "par":
+        return (yield elem)
+    elif kind == "return":
+        ctx.return_type = yield elem
         return Roff()
-    
-    # This element appears in various parts of the documentation, i.e. to indicate the type of a struct field.
-    # Just visit its children without any other special handling.
-    if elem.tag == "type":
-        return process_children(ctx, elem)
-
-    # Misc tags to visit that might be encountered during normal parsing.
-    # Don't do anything special with them, just visit their children.
-    if elem.tag in ["briefdescription", "detaileddescription", "parameterdescription"]:
-        return process_children(ctx, elem)
-
-    # Ignore all other commands.
-    if elem.tag in ["emoji", "table", "image", "formula"]:
-        print("warning: ignoring \\{0} command".format(elem.tag), file=args.stdout)
+    elif kind == "see":
+        # Visit the child elements but discard the Roff result. The purpose
+        # for visiting the children is to check what's being referenced:
+        # If it's a function, then it will be added to the SEE ALSO
+        # section of the man page (see "ref" element handler).
+        yield elem
         return Roff()
-
-    # Misc tags: https://www.doxygen.nl/manual/htmlcmds.html
-    tags = {
-        "ndash": "\\[en]",
-        "mdash": "\\[em]",
-    }
-    if elem.tag in tags:
-        roff = Roff()
-        roff.append_text(tags[elem.tag])
-        return roff
-
-    # Raise an exception for unknown tags so we're alerted
-    # to then and can properly deal with it.
-    raise Exception("unknown node", elem.tag)
-
-def process_brief(elem: Optional[lxml.etree._Element]) -> str:
+    elif kind in ["since", "note", "warning", "attention"]:
+        print("warning: excluding admonition from generated documentation", file=ctx.session.args.stdout)
+        return Roff()
+    elif kind in ["author", "authors"]:
+        ctx.authors.append((yield elem))
+        return Roff()
+    else:
+        raise Exception("unknown simplesect kind", kind)
+
+# Referencable section.
+@handles("xrefsect")
+def process_xrefsect(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    title_xml = elem.find("xreftitle")
+    if title_xml is not None and title_xml.text is not None:
+        if title_xml.text == "Bug":
+            description_xml = elem.find("xrefdescription")
+            assert description_xml is not None
+            ctx.bugs.append((yield description_xml))
+        elif title_xml.text == "Deprecated":
+            description_xml = elem.find("xrefdescription")
+            assert description_xml is not None
+            ctx.deprecated.append((yield description_xml))
+        else:
+            print("warning: unsupported xrefsect: {0}".format(title_xml.text), file=ctx.session.args.stdout)
+    return Roff()
+
+# Move to the next line.
+@handles("linebreak")
+def process_linebreak(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    roff = Roff()
+    roff.append_macro(".br")
+    return roff
+
+# Title elements should be extracted manually by their parent element.
+# Their content should not be emitted here otherwise it will appear
+# twice in the output.
+# Index tags are only useful for LaTeX and DocBook formats.
+# They have no use in man pages so no warning is needed.
+@handles("title", "indexentry")
+def process_nothing(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    return Roff()
+
+# Visit the children of these elements without any other special handling:
+# - Anchor tags are meant to be linked to but have no usage in man pages.
+# - The <highlight> elements appears in <programlisting> blocks.
+#   They are used to indicate which keywords are to be highlighted.
+#   Styling isn't applied to code examples in man page output so return their content as-is.
+# - The <type> element appears in various parts of the documentation, i.e. to indicate the type of a struct field.
+# - Misc tags that might be encountered during normal parsing.
+@handles("anchor", "highlight", "type", "briefdescription", "detaileddescription", "parameterdescription")
+def process_transparent(ctx: Context, elem: lxml.etree._Element) -> Visit:
+    return (yield elem)
+
+# Ignore all other commands.
+@handles("emoji", "table", "image", "formula")
+def process_unsupported(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    print("warning: ignoring \\{0} command".format(elem.tag), file=ctx.session.args.stdout)
+    return Roff()
+
+# Misc tags: https://www.doxygen.nl/manual/htmlcmds.html
+SYMBOLS = {
+    "ndash": "\\[en]",
+    "mdash": "\\[em]",
+}
+
+@handles(*SYMBOLS)
+def process_symbol(ctx: Context, elem: lxml.etree._Element) -> Roff:
+    roff = Roff()
+    roff.append_text(SYMBOLS[elem.tag])
+    return roff
+
+def process_brief(session: Session, elem: Optional[lxml.etree._Element]) -> str:
     # Brief descriptions should consist of a single line so remove any
     # commands, like .PP, because they will force text onto another line.
-    roff = process_as_roff(Context(True), elem)
+    roff = process_as_roff(Context(session, True), elem)
     roff.entries = list(filter(lambda x: isinstance(x, Text), roff.entries))
     return str(roff).strip()
 
@@ -616,16 +896,29 @@ def process_description(ctx: Context, elem: Optional[lxml.etree._Element]) -> st
     roff = process_as_roff(ctx, elem)
     return str(roff)
 
+# Concatenate the text of an element and its descendants.
+# The text of every element is stripped of leading and trailing whitespace before it is
+# concatenated with the text of its parent. An explicit stack is used instead of recursion
+# so the depth of the XML is not limited by the Python call stack.
 def process_text(elem: Optional[lxml.etree._Element]) -> str:
-    text = ""
-    if elem is not None:
-        if elem.text:
-            text += elem.text
-        for child in elem:
-            text += process_text(child)
-            if child.tail:
-                text += child.tail
-    return text.strip()
+    if elem is None:
+        return ""
+    stack: List[Tuple[lxml.etree._Element, List[str], Iterator[lxml.etree._Element]]] = []
+    stack.append((elem, [elem.text or ""], iter(elem)))
+    while True:
+        node, parts, children = stack[-1]
+        child = next(children, None)
+        if child is not None:
+            stack.append((child, [child.text or ""], iter(child)))
+            continue
+        text = "".join(parts).strip()
+        stack.pop()
+        if len(stack) == 0:
+            return text
+        parent_parts = stack[-1][1]
+        parent_parts.append(text)
+        if node.tail:
+            parent_parts.append(node.tail)
 
 def lowerify(text: str) -> str:
     if len(text) == 0:
@@ -637,7 +930,7 @@ def lowerify(text: str) -> str:
 def briefify(brief: str) -> str:
     return lowerify(brief).rstrip('.') # Remove trailing punctuation.
 
-def emit_special_sections(ctx: Context, file: TextIOWrapper) -> None:
+def emit_special_sections(ctx: Context, file: TextIO) -> None:
     if len(ctx.deprecated) > 0:
         file.write('.\\" --------------------------------------------------------------------------\n')
         file.write('.SH DEPRECATION\n')
@@ -678,17 +971,32 @@ def emit_special_sections(ctx: Context, file: TextIOWrapper) -> None:
         file.write(str(roff))
         file.write("\n")
 
-    if len(ctx.referenced_functions) > 0:
+    pages = see_also(ctx)
+    if len(pages) > 0:
         file.write('.\\" --------------------------------------------------------------------------\n')
         file.write('.SH SEE ALSO\n')
-        for index,page in enumerate(ctx.referenced_functions):
+        for index,page in enumerate(pages):
             file.write(f'.BR {page} (3)')
-            if index < len(ctx.referenced_functions) - 1:
+            if index < len(pages) - 1:
                 file.write(',')
             file.write('\n')
 
+# List the man pages for the SEE ALSO section: the functions referenced by the documentation followed
+# by the other functions in the same group. Man pages never reference themselves, i.e. if this man page
+# documents function X, then function X is excluded.
+def see_also(ctx: Context) -> List[str]:
+    limit = ctx.session.args.see_also_limit
+    pages = [page for page in ctx.referenced_functions if page != ctx.page_name][:limit]
+    for page in ctx.group_functions:
+        if limit is not None and len(pages) >= limit:
+            break
+        if page != ctx.page_name and page not in ctx.referenced_functions:
+            pages.append(page)
+    return pages
+
 # Construct the '.TH' macro.
-def heading() -> str:
+def heading(session: Session) -> str:
+    args, state = session.args, session.state
     assert state.project_name is not None
     params: List[str] = []
 
@@ -766,23 +1074,35 @@ def parse_function_signature(element: lxml.etree._Element) -> str:
     signature += ');"'
     return signature
 
-def parse_function(element: lxml.etree._Element, header_display_name: str) -> None:
+# The brief description and signature of a function appear on the man page of the header declaring
+# it and on the man page of the function itself. They are rendered once, with the header, and reused.
+class FunctionSynopsis:
+    __slots__ = ("brief", "signature")
+
+    def __init__(self, session: Session, element: lxml.etree._Element) -> None:
+        self.brief = process_brief(session, element.find("briefdescription"))
+        self.signature = parse_function_signature(element)
+
+def parse_function(session: Session, element: lxml.etree._Element, header_display_name: str, synopsis: Optional[FunctionSynopsis] = None) -> Page:
     id = element.get("id")
     assert id is not None, "function must have a Doxygen assigned identifier"
 
-    ctx = Context()
+    args, state = session.args, session.state
+    ctx = Context(session)
     if id in state.compounds:
         compound = state.compounds[id]
         if isinstance(compound, Function):
             ctx.active_function = compound
 
+    if synopsis is None:
+        synopsis = FunctionSynopsis(session, element)
     name = process_text(element.find("name"))
-    brief = briefify(process_brief(element.find("briefdescription")))
+    brief = briefify(synopsis.brief)
     description = process_description(ctx, element.find("detaileddescription"))
-    file = open(output_path(f"{name}.3"), "w", encoding="utf-8")
+    file = io.StringIO()
     if args.preamble is not None:
         file.write(args.preamble)
-    file.write(heading())
+    file.write(heading(session))
     file.write(".SH NAME\n")
     file.write(f'{name} \\- {brief}\n')
     if state.project_brief is not None:
@@ -794,7 +1114,7 @@ def parse_function(element: lxml.etree._Element, header_display_name: str) -> No
     file.write('.nf\n')
     file.write(f'.B #include <{header_display_name}>\n')
     file.write('.PP\n')
-    file.write(parse_function_signature(element) + "\n")
+    file.write(synopsis.signature + "\n")
     file.write('.fi\n')
 
     if len(description) > 0:
@@ -806,7 +1126,7 @@ def parse_function(element: lxml.etree._Element, header_display_name: str) -> No
     if ctx.function_params is not None and args.function_parameters is True:
         file.write('.\\" --------------------------------------------------------------------------\n')
         file.write('.SH PARAMETERS\n')
-        file.write(str(ctx.function_params))
+        file.write(str(function_parameters(ctx)))
         file.write("\n")
 
     if ctx.return_type is not None:
@@ -825,27 +1145,25 @@ def parse_function(element: lxml.etree._Element, header_display_name: str) -> No
             # Add all functions belonging to the same group as this one to its SEE ALSO man page section.
             compound = state.compounds[group_id]
             if isinstance(compound, Group):
-                ctx.referenced_functions = ctx.referenced_functions.union(compound.functions)
-
-    # Discard circular references, i.e. if this man page documents function X, then exclude
-    # function X from the SEE ALSO section of its own man page.
-    if name in ctx.referenced_functions:
-        ctx.referenced_functions = ctx.referenced_functions.difference(set([name]))
+                ctx.group_functions = compound.see_also
+    ctx.page_name = name
 
     emit_special_sections(ctx, file)
 
     if args.epilogue is not None:
         file.write(args.epilogue)
-    file.close()
+    return (f"{name}.3", file.getvalue())
 
-def output_path(file: str) -> str:
+def output_path(args: Arguments, file: str) -> str:
     return os.path.join(args.output, file)
 
-def parse_header(element: lxml.etree._Element) -> None:
-    ctx = Context()
+# The synopses of the functions declared by the header are recorded in 'synopses' by identifier.
+def parse_header(session: Session, element: lxml.etree._Element, synopses: Dict[str, FunctionSynopsis]) -> Page:
+    args, state = session.args, session.state
+    ctx = Context(session)
     header_name = process_text(element.find("compoundname"))
     header_display_name = header_name
-    header_brief = briefify(process_brief(element.find("briefdescription")))
+    header_brief = briefify(process_brief(session, element.find("briefdescription")))
     content = process_as_roff(ctx, element.find("detaileddescription"))
     functions = Roff()
     composite_types = Roff()
@@ -924,11 +1242,14 @@ def parse_header(element: lxml.etree._Element) -> None:
             for memberdef in sectiondef.findall("memberdef"):
                 name_xml = memberdef.find("name")
                 name = (name_xml.text or "") if name_xml is not None else ""
-                brief = process_brief(memberdef.find("briefdescription"))
+                synopsis = FunctionSynopsis(session, memberdef)
+                id = memberdef.get("id")
+                if id is not None:
+                    synopses[id] = synopsis
                 content.append_macro('.TP')
                 content.append_macro(f'.BR {name} (3)')
-                content.append_text(brief)
-                functions.append_macro(parse_function_signature(memberdef))
+                content.append_text(synopsis.brief)
+                functions.append_macro(synopsis.signature)
                 ctx.referenced_functions.add(name)
         elif kind == "typedef":
             for memberdef in sectiondef.findall("memberdef"):
@@ -936,8 +1257,8 @@ def parse_header(element: lxml.etree._Element) -> None:
                 if name_xml is not None and name_xml.text is not None:
                     type_xml = memberdef.find("type")
                     if type_xml is not None:
-                        type_content = process_brief(type_xml)
-                        brief = process_brief(memberdef.find("briefdescription"))
+                        type_content = process_brief(session, type_xml)
+                        brief = process_brief(session, memberdef.find("briefdescription"))
                         description_roff = process_as_roff(ctx, memberdef.find("detaileddescription"))
                         content.append_macro('.\\" -------------------------------------')
                         content.append_macro(f'.SS The {name_xml.text} type')
@@ -961,7 +1282,7 @@ def parse_header(element: lxml.etree._Element) -> None:
             for memberdef in sectiondef.findall("memberdef"):
                 name_xml = memberdef.find("name")
                 if name_xml is not None and name_xml.text is not None:
-                    brief = process_brief(memberdef.find("briefdescription"))
+                    brief = process_brief(session, memberdef.find("briefdescription"))
                     description_roff = process_as_roff(ctx, memberdef.find("detaileddescription"))
                     content.append_macro('.\\" -------------------------------------')
                     content.append_macro(f'.SS The {name_xml.text} enumeration')
@@ -984,7 +1305,7 @@ def parse_header(element: lxml.etree._Element) -> None:
                     content.append_macro('.PP')
                     for enumval in memberdef.findall("enumvalue"):
                         name = process_text(enumval.find("name"))
-                        brief = process_brief(enumval.find("briefdescription"))
+                        brief = process_brief(session, enumval.find("briefdescription"))
                         if len(brief) > 0:
                             description_roff = process_as_roff(ctx, enumval.find("detaileddescription")).simplify()
                             content.append_macro(".TP")
@@ -997,7 +1318,7 @@ def parse_header(element: lxml.etree._Element) -> None:
             for memberdef in sectiondef.findall("memberdef"):
                 name_xml = memberdef.find("name")
                 if name_xml is not None and name_xml.text is not None:
-                    brief = process_brief(memberdef.find("briefdescription"))
+                    brief = process_brief(session, memberdef.find("briefdescription"))
                     description_roff = process_as_roff(ctx, memberdef.find("detaileddescription"))
                     type_xml = memberdef.find("type")
                     name_xml = memberdef.find("name")
@@ -1037,7 +1358,7 @@ def parse_header(element: lxml.etree._Element) -> None:
                             if index < len(params) - 1:
                                 signature += ","
                         signature += ")"
-                    brief = process_brief(memberdef.find("briefdescription"))
+                    brief = process_brief(session, memberdef.find("briefdescription"))
                     ctx.clear_signature()
                     description_roff = process_as_roff(ctx, memberdef.find("detaileddescription"))
                     content.append_macro('.\\" -------------------------------------')
@@ -1055,7 +1376,7 @@ def parse_header(element: lxml.etree._Element) -> None:
                     content.append_macro('.PP')
                     if ctx.function_params is not None and args.macro_parameters is True:
                         content.append_text(f"The parameters to the\n.I {name_xml.text}\nmacro are as follows:\n")
-                        content.append_roff(ctx.function_params)
+                        content.append_roff(function_parameters(ctx))
 
     synopsis = Roff()
     synopsis.append_macro('.SH SYNOPSIS')
@@ -1083,10 +1404,10 @@ def parse_header(element: lxml.etree._Element) -> None:
         synopsis.pop(len(synopsis) - 1)
     synopsis.append_macro('.fi')
 
-    file = open(output_path(f"{header_name}.3"), "w", encoding="utf-8")
+    file = io.StringIO()
     if args.preamble is not None:
         file.write(args.preamble)
-    file.write(heading())
+    file.write(heading(session))
     file.write(".SH NAME\n")
     file.write(f'{header_name} \\- {header_brief}\n')
     if state.project_brief is not None:
@@ -1108,7 +1429,7 @@ def parse_header(element: lxml.etree._Element) -> None:
 
     if args.epilogue is not None:
         file.write(args.epilogue)
-    file.close()
+    return (f"{header_name}.3", file.getvalue())
 
 # Doxygen can begin Doxyfile options with quotes.
 # Remove them here.
@@ -1119,92 +1440,118 @@ def dequote(string: str) -> str:
         string = string[:-1]
     return string
 
-def preparse_xml(file: str) -> None:
-    tree = lxml.etree.parse(file)
-    if tree.getroot().tag == "doxyfile":
-        project_name_xml = cast(List[lxml.etree._Element], tree.xpath("//option[@id='PROJECT_NAME']/value"))
-        project_brief_xml = cast(List[lxml.etree._Element], tree.xpath("//option[@id='PROJECT_BRIEF']/value"))
-        project_number_xml = cast(List[lxml.etree._Element], tree.xpath("//option[@id='PROJECT_NUMBER']/value"))
-        if len(project_name_xml) > 0:
-            if text := project_name_xml[0].text:
-                state.project_name = dequote(text)
-        if len(project_brief_xml) > 0:
-            if text := project_brief_xml[0].text:
-                state.project_brief = dequote(project_brief_xml[0].text)
-        if len(project_number_xml) > 0:
-            if text := project_number_xml[0].text:
-                state.project_version = dequote(project_number_xml[0].text)
+# Record a project setting from "doxyfile.xml".
+def preparse_option(session: Session, id: str, value_xml: Optional[lxml.etree._Element]) -> None:
+    state = session.state
+    if value_xml is None or not value_xml.text:
         return
+    if id == "PROJECT_NAME":
+        state.project_name = dequote(value_xml.text)
+    elif id == "PROJECT_BRIEF":
+        state.project_brief = dequote(value_xml.text)
+    elif id == "PROJECT_NUMBER":
+        state.project_version = dequote(value_xml.text)
+
+# Record a member definition of a header file where 'kind' is the kind of its parent <sectiondef>.
+def preparse_memberdef(session: Session, kind: Optional[str], memberdef: lxml.etree._Element) -> None:
+    state = session.state
+    if kind == "func":
+        name = process_text(memberdef.find("name"))
+        if len(name) > 0:
+            group_id: Optional[str] = None
+            id = memberdef.get("id")
+            if id is not None:
+                if id.startswith("group__"):
+                    endpos = id.index("_1")
+                    if endpos > 0:
+                        group_id = id[:endpos]
+                function = Function(name, group_id)
+                state.compounds[id] = function
+                # Remember names of function parameter.
+                # Note that the following XPath recursivly searches the XML.
+                for param in memberdef.findall('.//parameterlist[@kind="param"]/*/*/parametername'):
+                    if param.text is not None:
+                        function.params.add(param.text)
+    elif kind == "typedef":
+        id = memberdef.get("id")
+        assert id is not None
+        name_xml = memberdef.find("name")
+        if name_xml is not None and name_xml.text is not None:
+            state.compounds[id] = Typedef(name_xml.text)
+    elif kind == "enum":
+        id = memberdef.get("id") ; assert id is not None
+        name_xml = memberdef.find("name")
+        if name_xml is not None and name_xml.text is not None and id is not None:
+            state.compounds[id] = Enum(name_xml.text)
+            # Store all enumeration members in the same dictionary as the enumeration itself.
+            # This is done because when Doxygen references them it does so using a global identifier.
+            for enumval in memberdef.findall("enumvalue"):
+                id = enumval.get("id") ; assert id is not None
+                name_xml = enumval.find("name")
+                if name_xml is not None and name_xml.text is not None:
+                    state.compounds[id] = EnumElement(name_xml.text)
+    elif kind == "define":
+        id = memberdef.get("id") ; assert id is not None
+        name_xml = memberdef.find("name")
+        if name_xml is not None and name_xml.text is not None and id is not None:
+            state.compounds[id] = Define(name_xml.text)
+
+# Record a struct or union whose documentation is written to its own XML file.
+# If 'file' is specified, then the definition is not retained and is parsed from it again when it is needed.
+def preparse_composite(session: Session, is_struct: bool, element: lxml.etree._Element, file: Optional[str] = None) -> None:
+    state = session.state
+    name_xml = element.find("compoundname")
+    if name_xml is not None:
+        if name_xml.text is not None:
+            id = element.get("id")
+            assert id is not None
+            state.compounds[id] = CompositeType(is_struct, name_xml.text, element if file is None else None, file)
+
+# Extract examples to latter include in the associated header file.
+# The examples associated with said header file will be added
+# to the EXAMPLES man page section of said header file.
+# If 'file' is specified, then the example is not retained and is parsed from it again when it is needed.
+def preparse_example(session: Session, element: lxml.etree._Element, file: Optional[str] = None) -> None:
+    state = session.state
+    location_xml = element.find("location")
+    description_xml = element.find("detaileddescription")
+    if location_xml is not None \
+        and description_xml is not None:
+        file_xml = location_xml.get("file")
+        if file_xml is not None:
+            example = Example(description_xml if file is None else None, file)
+            if file_xml in state.examples:
+                state.examples[file_xml].append(example)
+            else:
+                state.examples[file_xml] = [example]
+
+# Discover the symbols declared in the XML tree and record them in the session.
+# Returns true if the tree documents a header file, i.e. it must be rendered by parse_xml().
+def preparse_xml(session: Session, tree: lxml.etree._ElementTree) -> bool:
+    state = session.state
+    if tree.getroot().tag == "doxyfile":
+        for id in ["PROJECT_NAME", "PROJECT_BRIEF", "PROJECT_NUMBER"]:
+            value_xml = cast(List[lxml.etree._Element], tree.xpath(f"//option[@id='{id}']/value"))
+            if len(value_xml) > 0:
+                preparse_option(session, id, value_xml[0])
+        return False
     element = tree.find("compounddef")
     if element is None:
-        return
+        return False
     kind = element.get("kind")
     # Only consider source files (e.g. ignore Markdown files).
     language = element.get("language")
     if language == "C++":
         # Doxygen writes docs for structs and unions in their own individual .xml files.
         if kind == "struct":
-            name_xml = element.find("compoundname")
-            if name_xml is not None:
-                if name_xml.text is not None:
-                    id = element.get("id")
-                    assert id is not None
-                    state.compounds[id] = CompositeType(True, name_xml.text, element)            
+            preparse_composite(session, True, element)
         elif kind == "union":
-            name_xml = element.find("compoundname")
-            if name_xml is not None:
-                if name_xml.text is not None:
-                    id = element.get("id")
-                    assert id is not None
-                    state.compounds[id] = CompositeType(False, name_xml.text, element)      
+            preparse_composite(session, False, element)
         elif kind == "file":
             # Parse all other definitions.
             for sectiondef in element.findall("sectiondef"):
-                kind = sectiondef.get("kind")
-                if kind == "func":
-                    for memberdef in sectiondef.findall("memberdef"):
-                        name = process_text(memberdef.find("name"))
-                        if len(name) > 0:
-                            group_id: Optional[str] = None
-                            id = memberdef.get("id")
-                            if id is not None:
-                                if id.startswith("group__"):
-                                    endpos = id.index("_1")
-                                    if endpos > 0:
-                                        group_id = id[:endpos]
-                                function = Function(name, group_id)
-                                state.compounds[id] = function
-                                # Remember names of function parameter.
-                                # Note that the following XPath recursivly searches the XML.
-                                for param in memberdef.findall('.//parameterlist[@kind="param"]/*/*/parametername'):
-                                    if param.text is not None:
-                                        function.params.add(param.text)
-                elif kind == "typedef":
-                    for memberdef in sectiondef.findall("memberdef"):
-                        id = memberdef.get("id")
-                        assert id is not None
-                        name_xml = memberdef.find("name")
-                        if name_xml is not None and name_xml.text is not None:
-                            state.compounds[id] = Typedef(name_xml.text)
-                elif kind == "enum":
-                    for memberdef in sectiondef.findall("memberdef"):
-                        id = memberdef.get("id") ; assert id is not None
-                        name_xml = memberdef.find("name")
-                        if name_xml is not None and name_xml.text is not None and id is not None:
-                            state.compounds[id] = Enum(name_xml.text)
-                            # Store all enumeration members in the same dictionary as the enumeration itself.
-                            # This is done because when Doxygen references them it does so using a global identifier.
-                            for enumval in memberdef.findall("enumvalue"):
-                                id = enumval.get("id") ; assert id is not None
-                                name_xml = enumval.find("name")
-                                if name_xml is not None and name_xml.text is not None:
-                                    state.compounds[id] = EnumElement(name_xml.text)
-                elif kind == "define":
-                    for memberdef in sectiondef.findall("memberdef"):
-                        id = memberdef.get("id") ; assert id is not None
-                        name_xml = memberdef.find("name")
-                        if name_xml is not None and name_xml.text is not None and id is not None:
-                            state.compounds[id] = Define(name_xml.text)
+                for memberdef in sectiondef.findall("memberdef"):
+                    preparse_memberdef(session, sectiondef.get("kind"), memberdef)
     # Track all groups and the functions that belong to them.
     # This is used to reference all other functions under each functions SEE ALSO man page section.
     elif kind == "group":
@@ -1218,23 +1565,136 @@ def preparse_xml(file: str) -> None:
                     if len(name) > 0:
                         group.functions.add(name)
         state.compounds[group_id] = group
-    # Extract examples to latter include in the associated header file.
-    # The examples associated with said header file will be added
-    # to the EXAMPLES man page section of said header file.
     elif kind == "example":
-        location_xml = element.find("location")
-        description_xml = element.find("detaileddescription")
-        if location_xml is not None \
-            and description_xml is not None:
-            file_xml = location_xml.get("file")
-            if file_xml is not None:
-                if file_xml in state.examples:
-                    state.examples[file_xml].append(Example(description_xml))
-                else:
-                    state.examples[file_xml] = [Example(description_xml)]
+        preparse_example(session, element)
+    return language == "C++" and kind == "file"
+
+# Streaming equivalent of preparse_xml() that reads the XML file incrementally.
+# Elements are discarded as soon as their symbols are recorded so peak memory stays flat regardless
+# of how large the XML file is. Struct, union, and example definitions are the exception: they are
+# retained in full because their documentation is rendered after discovery completes. In low memory
+# mode they are released too and parsed again when they are rendered.
+def preparse_xml_streaming(session: Session, file: str) -> bool:
+    args, state = session.args, session.state
+    reparse = file if args.low_memory else None
+    kind: Optional[str] = None
+    language: Optional[str] = None
+    section_kind: Optional[str] = None
+    group: Optional[Group] = None
+    options: Set[str] = set()
+    stack: List[lxml.etree._Element] = []
+
+    # Drop an element, and everything beneath it, from the partially built tree.
+    def release(elem: lxml.etree._Element) -> None:
+        elem.clear()
+        if len(stack) > 0:
+            stack[-1].remove(elem)
+
+    for event, elem in lxml.etree.iterparse(file, events=("start", "end")):
+        if event == "start":
+            if len(stack) == 1 and elem.tag == "compounddef":
+                kind = elem.get("kind")
+                language = elem.get("language")
+                if language != "C++" and kind == "group":
+                    group_id = elem.get("id")
+                    assert group_id is not None
+                    group = Group(group_id)
+            elif len(stack) == 2 and elem.tag == "sectiondef":
+                section_kind = elem.get("kind")
+            stack.append(elem)
+            continue
+
+        stack.pop()
+        depth = len(stack)
+        if depth == 0:
+            break # Finished the root element.
+        if stack[0].tag == "doxyfile":
+            if depth == 1 and elem.tag == "option":
+                id = elem.get("id")
+                # Only the first occurrence of a setting is honored.
+                if id is not None and id not in options:
+                    options.add(id)
+                    preparse_option(session, id, elem.find("value"))
+                release(elem)
+        elif depth == 1 and elem.tag == "compounddef":
+            if language == "C++" and kind in ["struct", "union"]:
+                preparse_composite(session, kind == "struct", elem, reparse)
+            elif language != "C++" and kind == "example":
+                preparse_example(session, elem, reparse)
+            elif group is not None:
+                state.compounds[group.id] = group
+        elif language == "C++" and kind in ["struct", "union"]:
+            continue # Retain the entire definition.
+        elif language != "C++" and kind == "example":
+            continue # Retain the entire definition.
+        elif depth == 3 and elem.tag == "memberdef":
+            if language == "C++" and kind == "file":
+                preparse_memberdef(session, section_kind, elem)
+            elif group is not None and section_kind == "func":
+                name = process_text(elem.find("name"))
+                if len(name) > 0:
+                    group.functions.add(name)
+            release(elem)
+        elif depth == 2:
+            release(elem)
+    return language == "C++" and kind == "file"
+
+# Build the list of functions referenced by the SEE ALSO section of each function in a group.
+# The list is shared by every function in the group; each man page excludes its own name when it is emitted.
+# When the section is limited to N entries, a man page lists at most N entries from its group plus one
+# for itself and one for each function its documentation referenced, so only that many are kept.
+def link_groups(session: Session) -> None:
+    args, state = session.args, session.state
+    for compound in state.compounds.values():
+        if isinstance(compound, Group):
+            compound.see_also = list(compound.functions)
+            if args.see_also_limit is not None:
+                del compound.see_also[args.see_also_limit + 1:]
+
+# Extract the documentation of the structs and unions discovered in their own XML files.
+def parse_composites(session: Session) -> None:
+    for compound in session.state.compounds.values():
+        if isinstance(compound, CompositeType):
+            if compound.element is None and compound.file is not None:
+                compound.element = lxml.etree.parse(compound.file).find("compounddef")
+                compound.file = None
+            if compound.element is not None:
+                compound.brief = process_brief(session, compound.element.find("briefdescription"))
+                compound.description = process_as_roff(Context(session), compound.element.find("detaileddescription"))
+                for sectiondef in compound.element.findall("sectiondef"):
+                    for memberdef in sectiondef.findall("memberdef"):
+                        field = Field()
+                        field.type = process_text(memberdef.find("type"))
+                        field.name = process_text(memberdef.find("name"))
+                        field.argstring = process_text(memberdef.find("argsstring"))
+                        field.brief = process_brief(session, memberdef.find("briefdescription"))
+                        # The detailed description of a field is not emitted by any man page section so it is not rendered.
+                        compound.fields.append(field)
+                compound.element = None # Drop the reference so Python can garbage collect the XML tree.
 
-def parse_xml(file: str) -> None:
-    tree = lxml.etree.parse(file)
+# Render the inline text of a reference to each compound once, rather than every time it is referenced.
+def link_references(session: Session) -> None:
+    state = session.state
+    for id, compound in state.compounds.items():
+        if isinstance(compound, Function):
+            # The function "foobar" appears as the bolded text "foobar (3)" in the man page.
+            state.references[id] = Reference(f"\\f[B]{compound.name}\\f[R](3)", compound.name)
+        elif isinstance(compound, CompositeType):
+            if compound.is_struct:
+                state.references[id] = Reference(f"\\f[I]struct {compound.name}\\f[R]")
+            else:
+                state.references[id] = Reference(f"\\f[I]union {compound.name}\\f[R]")
+        elif isinstance(compound, Enum):
+            state.references[id] = Reference(f"\\f[I]enum {compound.name}\\f[R]")
+        elif isinstance(compound, (EnumElement, Typedef, Define)):
+            state.references[id] = Reference(f"\\f[I]{compound.name}\\f[R]")
+
+# Render the man pages for a header file and the functions it declares.
+def parse_xml(session: Session, tree: lxml.etree._ElementTree) -> List[Page]:
+    return list(render_xml(session, tree))
+
+# Render the man pages for a header file one at a time so each can be written before the next is rendered.
+def render_xml(session: Session, tree: lxml.etree._ElementTree) -> Iterator[Page]:
     element = tree.find("compounddef")
     if element is None:
         return
@@ -1246,17 +1706,381 @@ def parse_xml(file: str) -> None:
     if kind == "file":
         header_display_name: Optional[str] = None
         location = element.find("location")
-        if location is not None and args.include_path == "full":
+        if location is not None and session.args.include_path == "full":
             header_display_name = location.get("file")
         if header_display_name is None:
             header_display_name = process_text(element.find("compoundname"))
-        parse_header(element)
+        synopses: Dict[str, FunctionSynopsis] = {}
+        yield parse_header(session, element, synopses)
         for sectiondef in element.findall("sectiondef"):
             if sectiondef.get("kind") == "func":
                 for memberdef in sectiondef.findall("memberdef"):
-                    parse_function(memberdef, header_display_name)
-
-def exec(doxyfile: str) -> int:
+                    synopsis = synopses.get(memberdef.get("id", ""))
+                    yield parse_function(session, memberdef, header_display_name, synopsis)
+
+# A compression format for --compress: the suffix of the compressed files and how to compress at a given level.
+class Compressor:
+    __slots__ = ("suffix", "compress", "level")
+
+    def __init__(self, suffix: str, compress: Callable[[bytes, int], bytes], level: int) -> None:
+        self.suffix = suffix
+        self.compress = compress
+        self.level = level # Used when no level is specified.
+
+# The gzip header records no modification time so compressed man pages are reproducible.
+COMPRESSORS = {
+    "gzip": Compressor(".gz", lambda data, level: gzip.compress(data, level, mtime=0), 9),
+    "bz2": Compressor(".bz2", lambda data, level: bz2.compress(data, level), 9),
+    "xz": Compressor(".xz", lambda data, level: lzma.compress(data, preset=level), 6),
+}
+
+# The name of the file a man page is written to.
+def page_file(args: Arguments, name: str) -> str:
+    if args.compress is None:
+        return name
+    return name + COMPRESSORS[args.compress].suffix
+
+# Encode a man page, compressing it if requested, and return the name of its file with its content.
+def encode_page(args: Arguments, page: Page) -> Tuple[str, bytes]:
+    name, text = page
+    # Encode the page exactly as writing it in text mode would.
+    data = text.replace("\n", os.linesep).encode("utf-8")
+    if args.compress is not None:
+        compressor = COMPRESSORS[args.compress]
+        level = compressor.level if args.compress_level is None else args.compress_level
+        data = compressor.compress(data, level)
+        name += compressor.suffix
+    return name, data
+
+# Write a man page unless the file already has identical content.
+# Leaving unchanged pages untouched preserves their modification time so tools
+# that install or index man pages do not reprocess them.
+# Returns True if the page was written.
+def write_page(args: Arguments, page: Page) -> bool:
+    return write_file(args, *encode_page(args, page))
+
+def write_file(args: Arguments, name: str, data: bytes) -> bool:
+    path = output_path(args, name)
+    try:
+        with open(path, "rb") as file:
+            if file.read() == data:
+                return False
+    except OSError:
+        pass
+    with open(path, "wb") as file:
+        file.write(data)
+    return True
+
+# Writes man pages on a background thread so rendering continues while earlier pages are written,
+# e.g. to a slow network filesystem. Pages are written in the order they are queued and at most
+# 'depth' rendered pages wait in the queue, bounding the memory they hold. A depth of zero writes
+# each page on the calling thread instead.
+# Compressed pages are compressed on a pool of threads, one per CPU, before they reach the writer.
+# The compressors release the GIL so pages are compressed in parallel with each other and rendering.
+class Writer:
+    def __init__(self, args: Arguments, depth: int) -> None:
+        self.args = args
+        self.written = 0
+        self.unchanged = 0
+        self.busy = 0.0 # Seconds spent writing pages, including waiting for them to be compressed.
+        self.waiting = 0.0 # Seconds the calling thread spent waiting for the writer.
+        self.error: Optional[BaseException] = None
+        self.queue: "queue.Queue[Union[Page, concurrent.futures.Future[Tuple[str, bytes]], None]]" = queue.Queue(depth)
+        self.thread: Optional[threading.Thread] = None
+        self.pool: Optional[concurrent.futures.ThreadPoolExecutor] = None
+        if depth > 0:
+            if args.compress is not None:
+                self.pool = concurrent.futures.ThreadPoolExecutor(os.cpu_count() or 1)
+            self.thread = threading.Thread(target=self.run, name="manos-writer", daemon=True)
+            self.thread.start()
+
+    def write_now(self, page: Union[Page, "concurrent.futures.Future[Tuple[str, bytes]]"]) -> None:
+        start = time.perf_counter()
+        if isinstance(page, concurrent.futures.Future):
+            written = write_file(self.args, *page.result())
+        else:
+            written = write_page(self.args, page)
+        if written:
+            self.written += 1
+        else:
+            self.unchanged += 1
+        self.busy += time.perf_counter() - start
+
+    def run(self) -> None:
+        while True:
+            page = self.queue.get()
+            if page is None:
+                return
+            # After a failure the remaining pages are discarded; the error is raised by close().
+            if self.error is None:
+                try:
+                    self.write_now(page)
+                except BaseException as error:
+                    self.error = error
+
+    def write(self, page: Page) -> None:
+        start = time.perf_counter()
+        if self.thread is None:
+            self.write_now(page)
+        elif self.pool is not None:
+            self.queue.put(self.pool.submit(encode_page, self.args, page))
+        else:
+            self.queue.put(page)
+        self.waiting += time.perf_counter() - start
+
+    # Wait for the queued pages to be written and raise the error that stopped the writer, if any.
+    def close(self) -> None:
+        if self.thread is not None:
+            start = time.perf_counter()
+            self.queue.put(None)
+            self.thread.join()
+            self.thread = None
+            if self.pool is not None:
+                self.pool.shutdown()
+                self.pool = None
+            self.waiting += time.perf_counter() - start
+        if self.error is not None:
+            raise self.error
+
+# Incremental regeneration records which pages each header file produced in a manifest stored
+# in the output directory. A header is skipped when its XML, and everything else its pages
+# depend upon, is unchanged since the manifest was written and all of its pages still exist.
+MANIFEST_FILE = ".manos-manifest.json"
+
+class ManifestEntry:
+    def __init__(self, digest: str, pages: List[str]) -> None:
+        self.digest = digest
+        self.pages = pages
+
+def load_manifest(args: Arguments) -> Dict[str, ManifestEntry]:
+    entries: Dict[str, ManifestEntry] = {}
+    try:
+        with open(output_path(args, MANIFEST_FILE), "r", encoding="utf-8") as fp:
+            manifest = json.load(fp)
+        for header, entry in manifest["headers"].items():
+            entries[header] = ManifestEntry(entry["digest"], entry["pages"])
+    except (OSError, ValueError, KeyError, TypeError, AttributeError):
+        return {} # A missing or malformed manifest means everything is regenerated.
+    return entries
+
+def save_manifest(args: Arguments, entries: Dict[str, ManifestEntry]) -> None:
+    headers = {header: {"digest": entry.digest, "pages": entry.pages} for header, entry in entries.items()}
+    with open(output_path(args, MANIFEST_FILE), "w", encoding="utf-8") as fp:
+        json.dump({"headers": headers}, fp, indent=1, sort_keys=True)
+
+# Digest of the inputs, besides the header XML itself, that influence the content of the man pages:
+# the Manos implementation, the output settings, the project metadata, and the discovered symbols.
+# Cross-references between headers only depend on the discovered symbols, not their XML, so editing
+# the documentation in one header does not invalidate the man pages of other headers.
+def dependency_digest(session: Session) -> str:
+    args, state = session.args, session.state
+    digest = hashlib.sha256()
+    def update(value: object) -> None:
+        digest.update(repr(value).encode("utf-8"))
+        digest.update(b"\0")
+    for source in sorted(glob.glob(os.path.join(os.path.dirname(__file__), "*.py"))):
+        with open(source, "rb") as fp:
+            digest.update(fp.read())
+    update([args.section, args.include_path, sorted(args.synopsis), args.topic, args.footer_middle,
+            args.footer_inside, args.header_middle, args.preamble, args.epilogue,
+            args.function_parameters, args.macro_parameters, args.composite_fields, args.see_also_limit,
+            args.compress, args.compress_level])
+    # Autofilled footers include the current date.
+    if args.autofill:
+        update(datetime.date.today())
+    update([state.project_name, state.project_brief, state.project_version])
+    for id in sorted(state.compounds):
+        compound = state.compounds[id]
+        if isinstance(compound, Function):
+            update((id, "function", compound.name, compound.group_id, sorted(compound.params)))
+        elif isinstance(compound, Group):
+            update((id, "group", list(compound.functions)))
+        elif isinstance(compound, CompositeType):
+            fields = [(field.type, field.name, field.argstring, field.brief) for field in compound.fields]
+            update((id, compound.is_struct, compound.name, compound.brief, str(compound.description), fields))
+        else:
+            update((id, type(compound).__name__, compound.name))
+    for file in sorted(state.examples):
+        for example in state.examples[file]:
+            update((file, lxml.etree.tostring(example.description)))
+    return digest.hexdigest()
+
+def header_digest(file: str, dependencies: str) -> str:
+    digest = hashlib.sha256(dependencies.encode("utf-8"))
+    with open(file, "rb") as fp:
+        digest.update(fp.read())
+    return digest.hexdigest()
+
+# The session of a worker process.
+# Each worker renders headers for a single run so, unlike the parent process, it can keep its session globally.
+worker_session: Optional[Session] = None
+
+# Worker processes receive a copy of the session, with its discovered symbols, when they start.
+# They also receive the element handlers because, depending upon how the worker was
+# started, handlers registered by downstream users might not exist in the worker.
+def init_worker(session: Session, worker_handlers: Dict[str, Handler]) -> None:
+    global worker_session
+    worker_session = session
+    HANDLERS.update(worker_handlers)
+
+# Render a header file in a worker process.
+# Warnings are captured and returned so the parent process can print them
+# in the same order as a serial run would. So are the uses of the reference table.
+def render_worker(file: str) -> Tuple[List[Page], str, int]:
+    session = worker_session
+    assert session is not None, "worker was not initialized"
+    session.args.stdout = io.StringIO()
+    hits = session.stats.reference_hits
+    pages = parse_xml(session, lxml.etree.parse(file))
+    return pages, session.args.stdout.getvalue(), session.stats.reference_hits - hits
+
+# Render a header file on a thread, reusing its tree if it was cached during discovery.
+# Like render_worker(), warnings and uses of the reference table are returned to the main thread.
+def render_thread(session: Session, file: str, tree: Optional[lxml.etree._ElementTree]) -> Tuple[List[Page], str, int]:
+    local = session.for_thread()
+    if tree is None:
+        tree = lxml.etree.parse(file)
+    pages = parse_xml(local, tree)
+    return pages, cast(io.StringIO, local.args.stdout).getvalue(), local.stats.reference_hits
+
+# Doxygen is skipped when a fingerprint of everything it reads matches the fingerprint recorded
+# after it last generated the XML. The fingerprint covers the Doxygen version, the configuration
+# (including the settings Manos appends to it and the environment variables it references), and the
+# size and modification time of each file Doxygen reads: the files selected by INPUT, EXAMPLE_PATH,
+# INCLUDE_PATH, and IMAGE_PATH, the input filters, and the LAYOUT_FILE, TAGFILES, and CITE_BIB_FILES.
+FINGERPRINT_FILE = ".manos-fingerprint"
+
+# The patterns Doxygen selects files in the INPUT directories with when FILE_PATTERNS is empty.
+DEFAULT_FILE_PATTERNS = [
+    "*.c", "*.cc", "*.cxx", "*.cpp", "*.c++", "*.java", "*.ii", "*.ixx", "*.ipp", "*.i++", "*.inl", "*.idl", "*.ddl",
+    "*.odl", "*.h", "*.hh", "*.hxx", "*.hpp", "*.h++", "*.l", "*.cs", "*.d", "*.php", "*.php4", "*.php5", "*.phtml",
+    "*.inc", "*.m", "*.markdown", "*.md", "*.mm", "*.dox", "*.py", "*.pyw", "*.f90", "*.f95", "*.f03", "*.f08",
+    "*.f18", "*.f", "*.for", "*.vhd", "*.vhdl", "*.ucf", "*.qsf", "*.ice",
+]
+
+# Read the settings of a Doxygen configuration file, following @INCLUDE directives.
+# Values are split on whitespace unless quoted, mirroring how Doxygen reads list settings,
+# and environment variables referenced as $(VAR) are expanded like Doxygen does.
+def read_doxyfile(path: str, working_dir: str, settings: Dict[str, List[str]], configs: List[str]) -> None:
+    if path in configs or not os.path.isfile(path):
+        return
+    configs.append(path)
+    with open(path, "r", encoding="utf-8", errors="replace") as fp:
+        text = fp.read().replace("\\\n", " ")
+    for line in text.splitlines():
+        match = re.match(r"\s*(@?[A-Za-z0-9_]+)\s*(\+?=)(.*)", line)
+        if match is None:
+            continue
+        key, operator, value = match.groups()
+        value = re.sub(r"\$\(([^)]*)\)", lambda variable: os.environ.get(variable.group(1), ""), value)
+        values = [quoted or bare for quoted, bare in re.findall(r'"([^"]*)"|(\S+)', value)]
+        if key == "@INCLUDE":
+            # Included files are searched for in the working directory and then in @INCLUDE_PATH.
+            for include in values:
+                for directory in [working_dir] + settings.get("@INCLUDE_PATH", []):
+                    candidate = os.path.join(working_dir, directory, include)
+                    if os.path.isfile(candidate):
+                        read_doxyfile(candidate, working_dir, settings, configs)
+                        break
+        elif operator == "+=":
+            settings.setdefault(key, []).extend(values)
+        else:
+            settings[key] = values
+
+# Doxygen writes the XML to XML_OUTPUT which is relative to OUTPUT_DIRECTORY, itself relative to the working directory.
+def doxygen_xml_dir(settings: Dict[str, List[str]], working_dir: str) -> str:
+    output_dir = " ".join(settings.get("OUTPUT_DIRECTORY", []))
+    xml_output = " ".join(settings.get("XML_OUTPUT", [])) or "xml"
+    return os.path.realpath(os.path.join(working_dir, output_dir, xml_output))
+
+def doxygen_fingerprint(args: Arguments, doxyfile: str, working_dir: str, doxygen_version: str) -> str:
+    digest = hashlib.sha256(doxygen_version.encode("utf-8"))
+    settings: Dict[str, List[str]] = {}
+    configs: List[str] = []
+    read_doxyfile(doxyfile, working_dir, settings, configs)
+    for config in configs:
+        with open(config, "rb") as fp:
+            digest.update(fp.read())
+    # The settings after expanding environment variables, which the files above do not capture.
+    digest.update(repr(sorted(settings.items())).encode("utf-8"))
+
+    # Files written by Doxygen and Manos would otherwise change the fingerprint of every run.
+    generated = [doxygen_xml_dir(settings, working_dir), os.path.realpath(args.output), doxyfile]
+
+    # Doxygen skips the INPUT files and directories named by EXCLUDE, relative to the working directory,
+    # and those whose name or absolute path matches one of the EXCLUDE_PATTERNS, e.g. "*/build/*".
+    excludes = [os.path.realpath(os.path.join(working_dir, path)) for path in settings.get("EXCLUDE", [])]
+    exclude_patterns = settings.get("EXCLUDE_PATTERNS", [])
+
+    def within(path: str, directories: List[str]) -> bool:
+        return any(path == directory or path.startswith(directory + os.sep) for directory in directories)
+
+    def excluded(path: str) -> bool:
+        name = os.path.basename(path)
+        return within(path, excludes) or any(fnmatch.fnmatch(name, pattern) or fnmatch.fnmatch(path, pattern) for pattern in exclude_patterns)
+
+    # Whether a file or directory found in one of the directories Doxygen reads is skipped.
+    def skipped(path: str, exclude: bool) -> bool:
+        return within(path, generated) or (exclude and excluded(path))
+
+    def fingerprint(path: str) -> None:
+        if within(path, generated):
+            return
+        try:
+            info = os.stat(path)
+        except OSError:
+            return
+        digest.update(f"{path}\0{info.st_size}\0{info.st_mtime_ns}\n".encode("utf-8"))
+
+    def fingerprint_paths(paths: List[str], wildcards: List[str], recursive: bool, exclude: bool = False) -> None:
+        for path in paths:
+            path = os.path.realpath(os.path.join(working_dir, path))
+            if exclude and excluded(path):
+                continue
+            if not os.path.isdir(path):
+                fingerprint(path)
+                continue
+            for root, dirs, files in os.walk(path):
+                if recursive:
+                    dirs[:] = sorted(directory for directory in dirs if not skipped(os.path.join(root, directory), exclude))
+                else:
+                    dirs.clear()
+                for file in sorted(files):
+                    if any(fnmatch.fnmatch(file, wildcard) for wildcard in wildcards) and not skipped(os.path.join(root, file), exclude):
+                        fingerprint(os.path.join(root, file))
+
+    # Doxygen reads the working directory when INPUT is empty.
+    file_patterns = settings.get("FILE_PATTERNS") or DEFAULT_FILE_PATTERNS
+    fingerprint_paths(settings.get("INPUT") or ["."], file_patterns, settings.get("RECURSIVE") == ["YES"], exclude=True)
+    fingerprint_paths(settings.get("EXAMPLE_PATH", []), settings.get("EXAMPLE_PATTERNS") or ["*"], settings.get("EXAMPLE_RECURSIVE") == ["YES"])
+    # Headers the preprocessor includes, and images which are copied next to the output.
+    fingerprint_paths(settings.get("INCLUDE_PATH", []), settings.get("INCLUDE_FILE_PATTERNS") or file_patterns, False)
+    fingerprint_paths(settings.get("IMAGE_PATH", []), ["*"], True)
+
+    # Tag files may be followed by the location of their documentation, e.g. "other.tag=../other/html",
+    # and Doxygen appends the ".bib" extension to bibliography files that lack it.
+    files = settings.get("LAYOUT_FILE", []) + [tagfile.split("=")[0] for tagfile in settings.get("TAGFILES", [])]
+    files += [bib if bib.endswith(".bib") else bib + ".bib" for bib in settings.get("CITE_BIB_FILES", [])]
+    fingerprint_paths(files, ["*"], False)
+
+    # Input filters are commands, e.g. "python3 filter.py", so every word naming a file is fingerprinted,
+    # as is the program of the command when it is found on the PATH. Filter patterns map a wildcard to a command.
+    filters = settings.get("INPUT_FILTER", []) + [pattern.partition("=")[2] for pattern in settings.get("FILTER_PATTERNS", [])]
+    if settings.get("FILTER_SOURCE_FILES") == ["YES"]:
+        filters += [pattern.partition("=")[2] for pattern in settings.get("FILTER_SOURCE_PATTERNS", [])]
+    for command in filters:
+        for index, word in enumerate(command.split()):
+            path = os.path.join(working_dir, word)
+            if os.path.isfile(path):
+                fingerprint(os.path.realpath(path))
+            elif index == 0:
+                program = shutil.which(word)
+                if program is not None:
+                    fingerprint(os.path.realpath(program))
+    return digest.hexdigest()
+
+def exec(session: Session, doxyfile: str, doxygen_version: str) -> Optional[str]:
+    args = session.args
     # Clone the doxyfile
     try:
         # Use the same working path as the Doxyfile.
@@ -1267,12 +2091,7 @@ def exec(doxyfile: str) -> int:
         shutil.copyfile(doxyfile, doxyfile_manos)
     except:
         print("error: cannot write to the directory of the doxygen configuration file", file=args.stderr)
-        return 1
-
-    # Generate output directory if it doesn't exist.
-    if len(args.output) > 0:
-        if not os.path.exists(args.output):
-            os.mkdir(args.output)
+        return None
 
     # Append additional options onto it.
     clone = open(doxyfile_manos, "a", encoding="utf-8")
@@ -1303,20 +2122,74 @@ def exec(doxyfile: str) -> int:
     clone.write("XML_OUTPUT = xml\n")
     clone.close()
 
-    # Generate the XML documentation.
-    # Type checking is disabled for run() because it would require
-    # declaring a custom TypedDict and it's not worth the hassle.
-    p = subprocess.Popen(["doxygen", "Doxyfile.manos"], stdout=subprocess.PIPE, stderr=subprocess.PIPE, cwd=working_dir)
-    result = p.communicate()
-    stdout = result[0].decode("utf-8")
-    stderr = result[1].decode("utf-8")
-    if len(stdout) > 0:
-        print(stdout, file=args.stdout)
-    if len(stderr) > 0:
-        print(stderr, file=args.stderr)
+    # Skip Doxygen if the XML it previously generated is up-to-date.
+    settings: Dict[str, List[str]] = {}
+    read_doxyfile(doxyfile_manos, working_dir, settings, [])
+    xml_dir = doxygen_xml_dir(settings, working_dir)
+    fingerprint_file = os.path.join(xml_dir, FINGERPRINT_FILE)
+    fingerprint = doxygen_fingerprint(args, doxyfile_manos, working_dir, doxygen_version)
+    previous: Optional[str] = None
+    if not args.force and os.path.exists(fingerprint_file):
+        with open(fingerprint_file, "r", encoding="utf-8") as fp:
+            previous = fp.read()
+
+    if previous == fingerprint:
+        print("Doxygen XML is up-to-date; skipping Doxygen", file=args.stdout)
+    else:
+        # Remove the old fingerprint first so an interrupted run is never mistaken for a complete one.
+        if os.path.exists(fingerprint_file):
+            os.remove(fingerprint_file)
+
+        # Generate the XML documentation.
+        # Type checking is disabled for run() because it would require
+        # declaring a custom TypedDict and it's not worth the hassle.
+        start = time.perf_counter()
+        p = subprocess.Popen(["doxygen", "Doxyfile.manos"], stdout=subprocess.PIPE, stderr=subprocess.PIPE, cwd=working_dir)
+        result = p.communicate()
+        session.stats.add_time("doxygen", time.perf_counter() - start)
+        stdout = result[0].decode("utf-8")
+        stderr = result[1].decode("utf-8")
+        if len(stdout) > 0:
+            print(stdout, file=args.stdout)
+        if len(stderr) > 0:
+            print(stderr, file=args.stderr)
+
+        if p.returncode == 0 and os.path.isdir(xml_dir):
+            with open(fingerprint_file, "w", encoding="utf-8") as fp:
+                fp.write(fingerprint)
+
+    # Delete the temporary Doxyfile cloned that was from the original.
+    if os.path.exists(doxyfile_manos):
+        os.remove(doxyfile_manos)
+    return xml_dir
+
+# Parse the XML files and yield their trees in the order given.
+# lxml releases the GIL while parsing so, with more than one loader thread, files are
+# parsed concurrently ahead of the caller. At most two files per thread are parsed ahead
+# of the caller to bound the memory held by trees that have not been consumed yet.
+def load_xml(args: Arguments, files: List[str]) -> Iterator[Tuple[str, lxml.etree._ElementTree]]:
+    if args.load_threads == 1:
+        for file in files:
+            yield file, lxml.etree.parse(file)
+        return
+    with concurrent.futures.ThreadPoolExecutor(args.load_threads) as executor:
+        pending: Deque[Tuple[str, concurrent.futures.Future[lxml.etree._ElementTree]]] = collections.deque()
+        for file in files:
+            pending.append((file, executor.submit(lxml.etree.parse, file)))
+            if len(pending) >= 2 * args.load_threads:
+                loaded, future = pending.popleft()
+                yield loaded, future.result()
+        while len(pending) > 0:
+            loaded, future = pending.popleft()
+            yield loaded, future.result()
+
+# Discover the symbols of every XML file and return the header files, whose man pages must be rendered,
+# along with the trees of those headers cached for the render pass. Returns None if there is nothing to render.
+def discover_xml(session: Session, xml_dir: str) -> Optional[Tuple[List[str], Dict[str, lxml.etree._ElementTree]]]:
+    args, state = session.args, session.state
 
     # Extract metadata from all XML files.
-    xml_files = glob.glob(os.path.join(working_dir, "xml", "*.xml"))
+    xml_files = glob.glob(os.path.join(xml_dir, "*.xml"))
 
     # Figure out which files to process and which to skip.
     if args.pattern is not None:
@@ -1331,49 +2204,185 @@ def exec(doxyfile: str) -> int:
     # Make sure there are XML files...
     if len(xml_files) == 0:
         print("error: no XML files match the pattern", file=args.stderr)
-        return 1
+        return None
 
     # Extract top-level documentation first.
-    for file in xml_files:
-        preparse_xml(file)
+    # Each file is parsed once: the trees of header files are kept, up to a bound, so the
+    # render pass below can reuse them. Headers beyond the bound are parsed again when rendered.
+    start = time.perf_counter()
+    headers: List[str] = []
+    trees: Dict[str, lxml.etree._ElementTree] = {}
+    if args.streaming:
+        for file in xml_files:
+            # The streaming parser discards the tree as it goes so there is nothing to cache.
+            if preparse_xml_streaming(session, file):
+                headers.append(file)
+    else:
+        for file, tree in load_xml(args, xml_files):
+            if preparse_xml(session, tree):
+                headers.append(file)
+                # Worker processes parse the headers they render so there is no point caching them.
+                if (args.jobs == 1 or args.threads) and (args.xml_cache_size is None or len(trees) < args.xml_cache_size):
+                    trees[file] = tree
 
     # There must be a project name specified in the Doxygen config.
     # If the user does not specify a name, then Doxygen will default to "My Project".
     assert state.project_name is not None
 
+    link_groups(session)
+    link_references(session)
+
     # Extract documentation for top-level compound data types.
     # Doxygen writes struct and union docs to their own XML files.
     # These are processed first before processing the header XML.
-    for compound in state.compounds.values():
-        if isinstance(compound, CompositeType):
-            if compound.element is not None:
-                compound.brief = process_brief(compound.element.find("briefdescription"))
-                compound.description = process_as_roff(Context(), compound.element.find("detaileddescription"))
-                for sectiondef in compound.element.findall("sectiondef"):
-                    for memberdef in sectiondef.findall("memberdef"):
-                        field = Field()
-                        field.type = process_text(memberdef.find("type"))
-                        field.name = process_text(memberdef.find("name"))
-                        field.argstring = process_text(memberdef.find("argsstring"))
-                        field.brief = process_brief(memberdef.find("briefdescription"))
-                        field.description = process_as_roff(Context(), memberdef.find("detaileddescription"))
-                        compound.fields.append(field)
-                compound.element = None # Drop the reference so Python can garbage collect the XML tree.
+    parse_composites(session)
+    session.stats.add_time("discovery", time.perf_counter() - start)
+    return headers, trees
+
+# Render the man pages of the given header files, yielding each header file with its pages.
+# Only header files produce man pages so all other XML files are not revisited.
+# Rendering a header only reads the discovered symbols so headers can be rendered
+# in parallel. Pages are yielded in header order to match the output of a serial run.
+# Start the worker processes that render header files with --jobs, unless --threads renders them instead.
+# They must be started before the writer starts its threads: forking a process that runs threads can deadlock
+# a worker on a lock one of those threads held. With the fork start method the pool starts every worker
+# along with the first task, so a trivial task is submitted right away.
+def start_workers(session: Session) -> Optional[concurrent.futures.ProcessPoolExecutor]:
+    args = session.args
+    if args.jobs == 1 or args.threads:
+        return None
+    workers = concurrent.futures.ProcessPoolExecutor(args.jobs, initializer=init_worker, initargs=(session, HANDLERS))
+    workers.submit(int)
+    return workers
+
+# Render the headers with the function that submits them to the threads or worker processes, and yield their pages in order.
+# At most two headers per worker are submitted ahead of the caller, like load_xml(), so the rendered pages are
+# consumed as rendering progresses rather than accumulating for the whole project.
+def render_ahead(session: Session, headers: List[str],
+                 submit: Callable[[str], "concurrent.futures.Future[Tuple[List[Page], str, int]]"]) -> Iterator[Tuple[str, Iterable[Page]]]:
+    args, stats = session.args, session.stats
+    pending: Deque[Tuple[str, concurrent.futures.Future[Tuple[List[Page], str, int]]]] = collections.deque()
+
+    def finish() -> Tuple[str, List[Page]]:
+        file, future = pending.popleft()
+        pages, warnings, hits = future.result()
+        args.stdout.write(warnings)
+        stats.reference_hits += hits
+        return file, pages
+
+    for file in headers:
+        pending.append((file, submit(file)))
+        if len(pending) >= 2 * args.jobs:
+            yield finish()
+    while len(pending) > 0:
+        yield finish()
+
+def render_headers(session: Session, headers: List[str], trees: Dict[str, lxml.etree._ElementTree],
+                   workers: Optional[concurrent.futures.ProcessPoolExecutor]) -> Iterator[Tuple[str, Iterable[Page]]]:
+    args = session.args
+    if args.jobs > 1 and args.threads:
+        # Release the trees of headers that were skipped.
+        rendered = set(headers)
+        for file in [file for file in trees if file not in rendered]:
+            del trees[file]
+        # The cached trees are taken as their headers are submitted so they are released as rendering progresses.
+        with concurrent.futures.ThreadPoolExecutor(args.jobs) as executor:
+            yield from render_ahead(session, headers, lambda file: executor.submit(render_thread, session, file, trees.pop(file, None)))
+    elif workers is not None:
+        yield from render_ahead(session, headers, lambda file: workers.submit(render_worker, file))
+    else:
+        # The cached trees belong to the first headers that were discovered.
+        uncached = [file for file in headers if file not in trees]
+        for file in headers:
+            if file in trees:
+                yield file, render_xml(session, trees.pop(file))
+        trees.clear() # Release the trees of headers that were skipped.
+        for file, tree in load_xml(args, uncached):
+            yield file, render_xml(session, tree)
+            del tree # Release the tree before the next one is parsed.
+
+# Render the man pages of the XML files and write them to the output directory.
+def process_xml(session: Session, xml_dir: str) -> int:
+    args, state, stats = session.args, session.state, session.stats
 
-    # Extract header file documentation next.
-    for file in xml_files:
-        parse_xml(file)
+    # Generate output directory if it doesn't exist.
+    if len(args.output) > 0:
+        if not os.path.exists(args.output):
+            os.mkdir(args.output)
 
-    # Delete the temporary Doxyfile cloned that was from the original.
-    if os.path.exists(doxyfile_manos):
-        os.remove(doxyfile_manos)
+    discovered = discover_xml(session, xml_dir)
+    if discovered is None:
+        return 1
+    headers, trees = discovered
+
+    # Skip header files whose man pages are up-to-date.
+    manifest: Dict[str, ManifestEntry] = {}
+    if args.incremental:
+        previous = load_manifest(args)
+        dependencies = dependency_digest(session)
+        stale: List[str] = []
+        for file in headers:
+            digest = header_digest(file, dependencies)
+            entry = previous.get(os.path.basename(file))
+            if entry is not None and entry.digest == digest \
+                and all(os.path.exists(output_path(args, page)) for page in entry.pages):
+                manifest[os.path.basename(file)] = entry
+            else:
+                manifest[os.path.basename(file)] = ManifestEntry(digest, [])
+                stale.append(file)
+        headers = stale
+
+    # Each page is handed to the writer as soon as it is rendered.
+    start = time.perf_counter()
+    workers = start_workers(session)
+    writer = Writer(args, args.write_queue)
+    try:
+        for file, pages in render_headers(session, headers, trees, workers):
+            names: List[str] = []
+            for page in pages:
+                writer.write(page)
+                names.append(page_file(args, page[0]))
+            if args.incremental:
+                manifest[os.path.basename(file)].pages = names
+    finally:
+        writer.close()
+        if workers is not None:
+            workers.shutdown()
+    stats.add_time("render", time.perf_counter() - start - writer.waiting)
+    stats.add_time("write", writer.busy)
+
+    if args.incremental:
+        # Remove the pages of headers that were not discovered this time, and the pages a regenerated
+        # header no longer produces, unless another header now produces a page of the same name.
+        current = set(page for entry in manifest.values() for page in entry.pages)
+        for entry in previous.values():
+            for page in entry.pages:
+                if page not in current and os.path.exists(output_path(args, page)):
+                    os.remove(output_path(args, page))
+        save_manifest(args, manifest)
+    if args.stats:
+        print(f"{writer.written} man pages written, {writer.unchanged} unchanged", file=args.stdout)
+        stats.report(args.stdout, len(state.references))
     return 0
 
-def main(doxyfile: str, arguments: Arguments) -> int:
-    # Reset globla state.
-    global state, args
-    state = State()
-    args = arguments
+# Render the man pages of the XML files, yielding each page as it is rendered rather than writing it.
+def generate_xml(session: Session, xml_dir: str) -> Iterator[Page]:
+    discovered = discover_xml(session, xml_dir)
+    if discovered is None:
+        raise RuntimeError("failed to generate man pages; see the error output")
+    headers, trees = discovered
+    workers = start_workers(session)
+    try:
+        for _, pages in render_headers(session, headers, trees, workers):
+            yield from pages
+    finally:
+        if workers is not None:
+            workers.shutdown()
+
+# Validate the arguments and return the directory of the XML to render, running Doxygen if necessary.
+# Returns None if the arguments are invalid or Doxygen could not be run.
+def locate_xml(session: Session, doxyfile: Optional[str]) -> Optional[str]:
+    args = session.args
 
     # For the premable to end with a new line character.
     # This ensures the first man page macro begins on its own line.
@@ -1383,18 +2392,74 @@ def main(doxyfile: str, arguments: Arguments) -> int:
     # Setup defaults.
     if args.section < 1 or args.section > 9:
         print("error: expected section in the inclusive range 1-9", file=args.stderr)
-        return 1
+        return None
+
+    if args.jobs < 1:
+        print("error: expected jobs to be a positive integer", file=args.stderr)
+        return None
+
+    if args.threads and args.jobs == 1:
+        print("error: expected more than one job when rendering with threads", file=args.stderr)
+        return None
+
+    if args.load_threads < 1:
+        print("error: expected load threads to be a positive integer", file=args.stderr)
+        return None
+
+    if args.compress is not None and args.compress not in COMPRESSORS:
+        print("error: unsupported compression format: {0}".format(args.compress), file=args.stderr)
+        return None
+
+    if args.compress_level is not None and (args.compress_level < 1 or args.compress_level > 9):
+        print("error: expected compression level in the inclusive range 1-9", file=args.stderr)
+        return None
+
+    if args.write_queue < 0:
+        print("error: expected write queue depth to be a non-negative integer", file=args.stderr)
+        return None
+
+    if args.xml_cache_size is not None and args.xml_cache_size < 0:
+        print("error: expected XML cache size to be a non-negative integer", file=args.stderr)
+        return None
+
+    if args.see_also_limit is not None and args.see_also_limit < 1:
+        print("error: expected SEE ALSO limit to be a positive integer", file=args.stderr)
+        return None
+
+    # Low memory mode discovers symbols with the streaming parser so no XML trees are cached.
+    if args.low_memory:
+        args.streaming = True
+
+    # Use XML that Doxygen already generated.
+    # The project name, brief, and version are read from "doxyfile.xml" which Doxygen writes alongside it.
+    if args.xml_dir is not None:
+        # The configuration file would be ignored, along with any Doxygen settings it implies.
+        if doxyfile:
+            print("error: expected either a configuration file or an XML directory, not both", file=args.stderr)
+            return None
+        if not os.path.isdir(args.xml_dir):
+            print("error: missing XML directory: {0}".format(args.xml_dir), file=args.stderr)
+            return None
+        if not os.path.exists(os.path.join(args.xml_dir, "doxyfile.xml")):
+            print("error: missing doxyfile.xml in the XML directory: {0}".format(args.xml_dir), file=args.stderr)
+            print("       doxygen 1.9.2 or newer writes it when GENERATE_XML is enabled", file=args.stderr)
+            return None
+        return args.xml_dir
+
+    if not doxyfile:
+        print("error: expected a configuration file or an XML directory", file=args.stderr)
+        return None
 
     # Check if the Doxygen configuration file exists.
     if not os.path.exists(doxyfile):
         print("error: missing configuration file: {0}".format(doxyfile), file=args.stderr)
-        return 1
+        return None
 
     # Verify Doxygen is installed.
     if shutil.which("doxygen") is None:
         print("error: could not find doxygen;", file=args.stderr)
         print("       please install it https://www.doxygen.nl/", file=args.stderr)
-        return 1
+        return None
 
     # Verify Doxygen version.
     p = subprocess.Popen(["doxygen", "--version"], stdout=subprocess.PIPE)
@@ -1415,14 +2480,37 @@ def main(doxyfile: str, arguments: Arguments) -> int:
     if version < (1, 9, 2):
         print(f"error: doxygen version 1.9.2 or newer is required, found version {raw_version}", file=args.stderr)
         print("       please upgrade it https://www.doxygen.nl/", file=args.stderr)
-        return 1
+        return None
 
     # Run the main program.
-    return exec(doxyfile)
+    return exec(session, doxyfile, result[0].decode("utf-8").strip())
+
+def main(doxyfile: Optional[str], arguments: Arguments) -> int:
+    # Every run has its own session so concurrent runs do not share state.
+    session = Session(arguments)
+    xml_dir = locate_xml(session, doxyfile)
+    if xml_dir is None:
+        return 1
+    return process_xml(session, xml_dir)
+
+# Equivalent of main() that yields the man pages instead of writing them.
+# Errors are reported like main() does, and then raised so the caller notices them.
+def generate(doxyfile: Optional[str], arguments: Arguments) -> Iterator[Page]:
+    session = Session(arguments)
+    xml_dir = locate_xml(session, doxyfile)
+    if xml_dir is None:
+        raise RuntimeError("failed to generate man pages; see the error output")
+    yield from generate_xml(session, xml_dir)
+
+# Converts the value of --xml-cache-size, where "all" caches every header file.
+def xml_cache_size(value: str) -> Optional[int]:
+    if value == "all":
+        return None
+    return int(value)
 
 def parse_args(arguments: Optional[List[str]] = None) -> int:
     parser = argparse.ArgumentParser(prog="manos", description="Man page generator for C projects.")
-    parser.add_argument("doxyfile")
+    parser.add_argument("doxyfile", nargs="?")
     parser.add_argument("-v", "--version", action="version", version='%(prog)s 1.0')
     parser.add_argument("-q", "--quite", action="store_true", dest="suppress_output", help="suppress output")
 
@@ -1452,6 +2540,22 @@ def parse_args(arguments: Optional[List[str]] = None) -> int:
     group.add_argument("--function-params", action="store_true", dest="function_parameters", help="include function \\param documentation in the functions man page")
     group.add_argument("--macro-params", action="store_true", dest="macro_parameters", help="include macro \\param documentation when documenting macros")
     group.add_argument("--composite-fields", action="store_true", dest="composite_fields", help="include documentation for struct and union fields when documenting them")
+    group.add_argument("--see-also-limit", type=int, dest="see_also_limit", help="list at most N man pages in the SEE ALSO section", metavar="N")
+
+    group = parser.add_argument_group()
+    group.add_argument("--streaming", action="store_true", dest="streaming", help="discover symbols with a streaming XML parser to reduce peak memory usage")
+    group.add_argument("--low-memory", action="store_true", dest="low_memory", help="keep at most one XML file in memory at a time; implies --streaming")
+    group.add_argument("-j", "--jobs", type=int, dest="jobs", default=1, help="number of worker processes used to render header files; defaults to 1", metavar="N")
+    group.add_argument("--threads", action="store_true", dest="threads", help="render with --jobs threads instead of worker processes, which requires --jobs greater than 1; scales on free-threaded Python builds")
+    group.add_argument("--write-queue", type=int, dest="write_queue", default=16, help="number of rendered man pages that may wait to be written by a background thread; 0 writes them while rendering; defaults to 16", metavar="N")
+    group.add_argument("--compress", type=str, dest="compress", choices=list(COMPRESSORS), help="compress the man pages with FORMAT, appending its suffix to their file names", metavar="FORMAT")
+    group.add_argument("--compress-level", type=int, dest="compress_level", help="compression level from 1-9; defaults to 9 for gzip and bz2 and 6 for xz", metavar="N")
+    group.add_argument("--incremental", action="store_true", dest="incremental", help="only regenerate man pages for header files that changed since the previous run")
+    group.add_argument("--xml-dir", type=str, dest="xml_dir", help="render existing Doxygen XML from PATH instead of running Doxygen; the doxyfile must not be given", metavar="PATH")
+    group.add_argument("--force", action="store_true", dest="force", help="always run Doxygen, even if its XML output is up-to-date")
+    group.add_argument("--stats", action="store_true", dest="stats", help="report how many man pages were written, the time spent in each phase of the run, and how often the reference table was used")
+    group.add_argument("--xml-cache-size", type=xml_cache_size, dest="xml_cache_size", default=64, help="number of parsed header files kept in memory between discovering symbols and rendering, or 'all'; defaults to 64", metavar="N")
+    group.add_argument("--load-threads", type=int, dest="load_threads", default=1, help="number of threads used to parse XML files; defaults to 1", metavar="N")
 
     group = parser.add_argument_group()
     group.add_argument("--topic", type=str, dest="topic", help="text positioned at the top of the man page; defaults to PROJECT_NAME in the Doxygen config", metavar="TEXT")
@@ -14,6 +14,8 @@
 #  along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 # This implementation is derived from: https://github.com/rspeer/ordered-set
+# It differs in that the elements are the keys of a dictionary, which preserves insertion
+# order, so removing an element is O(1). Indexing is O(n) as a consequence.
 
 import itertools as it
 import typing
@@ -21,7 +23,6 @@ import sys
 
 from typing import (
     Dict,
-    List,
     Iterable,
     Iterator,
     MutableSet,
@@ -42,22 +43,18 @@ OrderedSetInitializer = Union[AbstractSet[T], Sequence[T], Iterable[T]]
 
 class OrderedSet(MutableSet[T], Sequence[T]):
     def __init__(self, initial: Optional[OrderedSetInitializer[T]] = None):
-        self.items: List[T] = []
-        self.map: Dict[T, int] = {}
+        self.map: Dict[T, None] = {}
         if initial is not None:
-            # In terms of duck-typing, the default __ior__ is compatible with
-            # the types we use, but it doesn't expect all the types we
-            # support as values for `initial`.
-            self |= initial  # type: ignore
+            self.update(initial)
 
     # Returns the number of unique elements in the ordered set.
     def __len__(self) -> int:
-        return len(self.items)
+        return len(self.map)
 
     # Get the item at a given index.
     @overload
     def __getitem__(self, index: int) -> T:
-        return self.items[index]
+        ...
 
     # If `index` is a slice, you will get back that slice of items, as a new OrderedSet.
     @overload
@@ -68,64 +65,64 @@ class OrderedSet(MutableSet[T], Sequence[T]):
     # Disable type checking because the overloads provide the typed signatures.
     @typing.no_type_check
     def __getitem__(self, index):
-        result = self.items[index]
-        if isinstance(result, list):
-            return self.__class__(result)
-        else:
-            return result
+        if isinstance(index, slice):
+            return self.__class__(list(self.map)[index])
+        if index >= 0:
+            for item in it.islice(self.map, index, None):
+                return item
+        elif -index <= len(self.map):
+            for item in it.islice(reversed(self.map), -index - 1, None):
+                return item
+        raise IndexError("OrderedSet index out of range")
 
     # Return a shallow copy of this object.
     def copy(self) -> "OrderedSet[T]":
-        return self.__class__(self)
+        result = self.__class__()
+        result.map = self.map.copy()
+        return result
 
     def __contains__(self, key: object) -> bool:
         return key in self.map
 
     def append(self, key: T) -> int:
         if key not in self.map:
-            self.map[key] = len(self.items)
-            self.items.append(key)
-        return self.map[key]
+            self.map[key] = None
+            return len(self.map) - 1
+        return self.index(key)
 
     # Add `key` as an item to this OrderedSet.
     def add(self, key: T) -> None:
-        self.append(key)
+        self.map[key] = None
 
     # Get the index of a given entry, raising an IndexError if it's not present.
     def index(self, value: T, start: int = 0, stop: int = sys.maxsize) -> int:
-        if start == 0 and stop == sys.maxsize:
-            return self.map[value]
-        return self.items.index(value, start, stop)
+        if value not in self.map:
+            raise ValueError(f"{value!r} is not in OrderedSet")
+        return list(self.map).index(value, start, stop)
 
     # Remove and return item at index (default last). Raise an exception if absent.
     def pop(self, index: int = -1) -> T:
-        if not self.items:
+        if not self.map:
             raise KeyError("Set is empty")
-        elem = self.items[index]
-        del self.items[index]
+        if index == -1:
+            return self.map.popitem()[0]
+        elem = self[index]
         del self.map[elem]
         return elem
 
     # Remove an element. Do not raise an exception if absent.
     def discard(self, key: T) -> None:
-        if key in self:
-            i = self.map[key]
-            del self.items[i]
-            del self.map[key]
-            for k, v in self.map.items():
-                if v >= i:
-                    self.map[k] = v - 1
+        self.map.pop(key, None)
 
     # Remove all items from this OrderedSet.
     def clear(self) -> None:
-        del self.items[:]
         self.map.clear()
 
     def __iter__(self) -> Iterator[T]:
-        return iter(self.items)
+        return iter(self.map)
 
     def __reversed__(self) -> Iterator[T]:
-        return reversed(self.items)
+        return reversed(self.map)
 
     def __repr__(self) -> str:
         if not self:
@@ -146,31 +143,33 @@ class OrderedSet(MutableSet[T], Sequence[T]):
         else:
             return True if set(self) == other_as_set else False
 
+    # Adds all items of the other sets, in place. Items already present keep their position.
+    def update(self, *sets: OrderedSetInitializer[T]) -> None:
+        for items in sets:
+            self.map.update(dict.fromkeys(items))
+
+    # Removes all items of the other sets, in place.
+    def difference_update(self, *sets: OrderedSetInitializer[T]) -> None:
+        for items in sets:
+            for item in items:
+                self.map.pop(item, None)
+
     # Combines all unique items.
     def union(self, *sets: SetLike[T]) -> "OrderedSet[T]":
-        cls: type = OrderedSet
-        if isinstance(self, OrderedSet):
-            cls = self.__class__
-        containers = map(list, it.chain([self], sets))
-        items = it.chain.from_iterable(containers)
-        return cls(items)
+        result = self.copy()
+        result.update(*sets)
+        return result
 
     # Returns elements in common between all sets. Order is defined only by the first set.
     def intersection(self, *sets: SetLike[T]) -> "OrderedSet[T]":
-        cls: type = OrderedSet
-        items: OrderedSetInitializer[T] = self
-        if isinstance(self, OrderedSet):
-            cls = self.__class__
+        result = self.copy()
         if sets:
             common = set.intersection(*map(set, sets))
-            items = (item for item in self if item in common)
-        return cls(items)
+            result.map = {item: None for item in self.map if item in common}
+        return result
 
     # Returns all elements that are in this set but not the others.
     def difference(self, *sets: SetLike[T]) -> "OrderedSet[T]":
-        cls = self.__class__
-        items: OrderedSetInitializer[T] = self
-        if sets:
-            other = set.union(*map(set, sets))
-            items = (item for item in self if item not in other)
-        return cls(items)
+        result = self.copy()
+        result.difference_update(*sets)
+        return result
@@ -0,0 +1,16 @@
+/*! \file functions-params-deprecated.h
+ *  \brief Testing commands nested in function parameters.
+ *
+ *  Lets see if commands in parameter descriptions reach their sections.
+ */
+
+/*! \brief Resizes a file.
+ *
+ *  Resizes the file descriptor \p fd to \p size bytes.
+ *
+ *  \param[in] fd File descriptor.
+ *  \param[in] size New size of the file.
+ *             \deprecated Sizes larger than the file are no longer supported.
+ *  \return Non-zero if the file was resized.
+ */
+int resize_me(int fd, int size);
@@ -13,22 +13,44 @@
 #  You should have received a copy of the GNU General Public License
 #  along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-from manos import process
-from manos.__main__ import parse_args
+from manos import generate, process, register_handler
+from manos.__main__ import parse_args, doxygen_fingerprint, Arguments, HANDLERS
 
-from typing import Set, List, Tuple, Optional, Generator, TextIO
+from typing import Any, Set, List, Tuple, Optional, Generator, TextIO
 from typing_extensions import TypedDict, Unpack
 
 import pytest
 import pytest_mock
+import lxml.etree
 import pathlib
+import concurrent.futures
+import gzip
+import lzma
 import filecmp
+import io
+import re
+import subprocess
+import threading
 import os
 
 class Params(TypedDict, total=False):
     function_parameters: bool
     macro_parameters: bool
     composite_fields: bool
+    see_also_limit: Optional[int]
+    streaming: bool
+    low_memory: bool
+    jobs: int
+    threads: bool
+    write_queue: int
+    compress: Optional[str]
+    compress_level: Optional[int]
+    load_threads: int
+    xml_cache_size: Optional[int]
+    incremental: bool
+    force: bool
+    xml_dir: Optional[str]
+    stats: bool
     topic: Optional[str]
     section: int
     include_path: str
@@ -100,6 +122,30 @@ def test_section_overflow(capsys: pytest.CaptureFixture[str]) -> None:
     assert parse_args(["--section", "10", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
     assert capsys.readouterr().err == "error: expected section in the inclusive range 1-9\n"
 
+def test_jobs_underflow(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--jobs", "0", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected jobs to be a positive integer\n"
+
+def test_threads_without_jobs(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--threads", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected more than one job when rendering with threads\n"
+
+def test_write_queue_underflow(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--write-queue", "-1", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected write queue depth to be a non-negative integer\n"
+
+def test_xml_cache_size_underflow(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--xml-cache-size", "-1", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected XML cache size to be a non-negative integer\n"
+
+def test_compress_level_overflow(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--compress", "gzip", "--compress-level", "10", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected compression level in the inclusive range 1-9\n"
+
+def test_see_also_limit_underflow(capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--see-also-limit", "0", os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected SEE ALSO limit to be a positive integer\n"
+
 # Test the minimum allowed section number.
 def test_section_min() -> None:
     assert_snapshot("empty", "snapshot-section-min", section=1)
@@ -159,12 +205,18 @@ def test_functions() -> None:
 def test_functions_params() -> None:
     assert_snapshot("functions-params")
 
+def test_functions_params_deprecated() -> None:
+    assert_snapshot("functions-params-deprecated")
+
 def test_functions_with_arguments_section() -> None:
     assert_snapshot("functions", "snapshot-arguments-section", function_parameters=True)
 
 def test_functions_grouped() -> None:
     assert_snapshot("functions-grouped")
 
+def test_functions_grouped_see_also_limit() -> None:
+    assert_snapshot("functions-grouped", "snapshot-see-also-limit", see_also_limit=1)
+
 def test_structs() -> None:
     assert_snapshot("structs")
 
@@ -232,10 +284,229 @@ def test_simple() -> None:
 def test_complex() -> None:
     assert_snapshot("complex")
 
+def test_complex_streaming() -> None:
+    assert_snapshot("complex", streaming=True)
+
+def test_complex_low_memory() -> None:
+    assert_snapshot("complex", low_memory=True)
+
+def test_examples_low_memory() -> None:
+    assert_snapshot("examples", low_memory=True)
+
+def test_complex_jobs() -> None:
+    assert_snapshot("complex", jobs=4)
+
+# Worker processes must be forked before the writer and the compression pool start their threads.
+def test_complex_jobs_forked_without_threads(mocker: pytest_mock.MockFixture, tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    fork = os.fork
+    running: List[int] = []
+    def counted_fork() -> int:
+        running.append(threading.active_count())
+        return fork()
+    mocker.patch("os.fork", counted_fork)
+    assert process("Doxyfile", output_dir=str(tmp_path), jobs=4, compress="gzip") == 0
+    assert all(count == 1 for count in running)
+
+def test_complex_threads() -> None:
+    assert_snapshot("complex", jobs=4, threads=True)
+
+# Threads report to the stderr passed to process(), like the main thread does.
+def test_complex_threads_stderr(mocker: pytest_mock.MockFixture, tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    mocker.patch.dict(HANDLERS)
+    para = HANDLERS["para"]
+    def reporting_para(ctx: Any, elem: Any) -> Any:
+        print("rendering a paragraph", file=ctx.session.args.stderr)
+        return para(ctx, elem)
+    register_handler("para", reporting_para)
+    serial, threaded = io.StringIO(), io.StringIO()
+    assert process("Doxyfile", output_dir=str(tmp_path / "serial"), stderr=serial) == 0
+    assert process("Doxyfile", output_dir=str(tmp_path / "threads"), jobs=4, threads=True, stderr=threaded) == 0
+    assert serial.getvalue().count("rendering a paragraph") > 0
+    assert threaded.getvalue().count("rendering a paragraph") == serial.getvalue().count("rendering a paragraph")
+
+def test_complex_write_queue() -> None:
+    assert_snapshot("complex", write_queue=0)
+
+def test_complex_xml_cache_size() -> None:
+    assert_snapshot("complex", xml_cache_size=0)
+
+def test_complex_xml_cache_size_unbounded() -> None:
+    assert_snapshot("complex", xml_cache_size=None)
+
+# Headers beyond the cache are parsed again when their man pages are rendered.
+def test_complex_xml_cache_size_exceeded(mocker: pytest_mock.MockFixture) -> None:
+    parse = mocker.spy(lxml.etree, "parse")
+    assert_snapshot("complex", xml_cache_size=1)
+    headers = [str(call.args[0]) for call in parse.call_args_list if str(call.args[0]).endswith("_8h.xml")]
+    # The three headers are parsed during discovery, and the two that were not cached are parsed again.
+    assert len(set(headers)) == 3
+    assert len(headers) == 5
+
+def test_complex_load_threads() -> None:
+    assert_snapshot("complex", load_threads=4)
+
 def test_complex_detailed_synopsis() -> None:
     assert_snapshot("complex", "complex-detailed-synopsis", synopsis=set(
         ["functions", "composites", "enums", "variables", "typedefs", "macros"]))
 
+def test_incremental(tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    assert process("Doxyfile", output_dir=str(tmp_path), incremental=True) == 0
+    assert len(filecmp.dircmp("snapshot", tmp_path).diff_files) == 0
+    # Unchanged headers are skipped so a page modified by hand is left as-is.
+    (tmp_path / "frob_new.3").write_text("stale")
+    assert process("Doxyfile", output_dir=str(tmp_path), incremental=True) == 0
+    assert (tmp_path / "frob_new.3").read_text() == "stale"
+    # Without the manifest every page is regenerated.
+    os.remove(tmp_path / ".manos-manifest.json")
+    assert process("Doxyfile", output_dir=str(tmp_path), incremental=True) == 0
+    assert len(filecmp.dircmp("snapshot", tmp_path).diff_files) == 0
+    # The pages of a header that is no longer discovered are removed.
+    assert process("Doxyfile", output_dir=str(tmp_path), incremental=True, exclusion_pattern="frob_8h.xml") == 0
+    assert not any(page.name.startswith("frob") for page in tmp_path.iterdir())
+    assert (tmp_path / "doodad_new.3").exists()
+
+def test_doxygen_skipped(mocker: pytest_mock.MockFixture) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    popen = mocker.spy(subprocess, "Popen")
+    def doxygen_runs() -> int:
+        return sum(1 for call in popen.call_args_list if call.args[0] == ["doxygen", "Doxyfile.manos"])
+    assert process("Doxyfile", force=True) == 0
+    assert doxygen_runs() == 1
+    # Nothing changed so the existing XML is reused.
+    assert process("Doxyfile") == 0
+    assert doxygen_runs() == 1
+    assert len(filecmp.dircmp("snapshot", "man").diff_files) == 0
+    # Touching an input file invalidates the XML.
+    os.utime("frob.h")
+    assert process("Doxyfile") == 0
+    assert doxygen_runs() == 2
+
+def test_doxygen_fingerprint_excludes(tmp_path: pathlib.Path) -> None:
+    for directory in ["include", "build", "tests"]:
+        (tmp_path / directory).mkdir()
+        (tmp_path / directory / "a.h").write_text("int a;")
+    (tmp_path / "notes.txt").write_text("notes")
+    (tmp_path / "Doxyfile").write_text("INPUT = .\nRECURSIVE = YES\nEXCLUDE = build\nEXCLUDE_PATTERNS = */tests/*\n")
+    args = Arguments()
+    args.output = str(tmp_path / "man")
+    def fingerprint() -> str:
+        return doxygen_fingerprint(args, str(tmp_path / "Doxyfile"), str(tmp_path), "1.9.8")
+    original = fingerprint()
+    # Excluded files, and files the default FILE_PATTERNS do not select, are not read by Doxygen.
+    (tmp_path / "build" / "a.h").write_text("int a, b;")
+    (tmp_path / "tests" / "a.h").write_text("int a, b;")
+    (tmp_path / "notes.txt").write_text("more notes")
+    assert fingerprint() == original
+    (tmp_path / "include" / "a.h").write_text("int a, b;")
+    assert fingerprint() != original
+
+def test_doxygen_skipped_environment(mocker: pytest_mock.MockFixture, monkeypatch: pytest.MonkeyPatch, tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    popen = mocker.spy(subprocess, "Popen")
+    def doxygen_runs() -> int:
+        return sum(1 for call in popen.call_args_list if call.args[0] == ["doxygen", "Doxyfile.manos"])
+    # Files named through environment variables are part of the fingerprint too.
+    monkeypatch.setenv("MANOS_IMAGES", str(tmp_path))
+    (tmp_path / "logo.png").write_bytes(b"logo")
+    settings = [("IMAGE_PATH", "$(MANOS_IMAGES)")]
+    assert process("Doxyfile", force=True, doxygen_settings=settings) == 0
+    assert process("Doxyfile", doxygen_settings=settings) == 0
+    assert doxygen_runs() == 1
+    (tmp_path / "logo.png").write_bytes(b"new logo")
+    assert process("Doxyfile", doxygen_settings=settings) == 0
+    assert doxygen_runs() == 2
+
+def test_xml_dir(mocker: pytest_mock.MockFixture, tmp_path: pathlib.Path) -> None:
+    # Generate the XML with Doxygen first, then render it again without Doxygen.
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    assert process("Doxyfile") == 0
+    popen = mocker.spy(subprocess, "Popen")
+    assert process(xml_dir="xml", output_dir=str(tmp_path)) == 0
+    assert popen.call_count == 0
+    assert len(filecmp.dircmp("snapshot", tmp_path).diff_files) == 0
+
+def test_xml_dir_without_doxyfile_xml(tmp_path: pathlib.Path, capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--xml-dir", str(tmp_path)]) == 1
+    assert capsys.readouterr().err == f"error: missing doxyfile.xml in the XML directory: {tmp_path}\n" \
+                                      "       doxygen 1.9.2 or newer writes it when GENERATE_XML is enabled\n"
+
+def test_xml_dir_with_doxyfile(tmp_path: pathlib.Path, capsys: pytest.CaptureFixture[str]) -> None:
+    assert parse_args(["--xml-dir", str(tmp_path), os.path.join(WORKING_DIR, "empty", "Doxyfile")]) == 1
+    assert capsys.readouterr().err == "error: expected either a configuration file or an XML directory, not both\n"
+
+def test_unchanged_pages_not_rewritten(tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    stdout = io.StringIO()
+    assert process("Doxyfile", output_dir=str(tmp_path), stdout=stdout) == 0
+    # The summary is only reported with the statistics.
+    assert "man pages written" not in stdout.getvalue()
+    mtimes = {page.name: page.stat().st_mtime_ns for page in tmp_path.iterdir()}
+    # Modify one page so it is the only page rewritten.
+    (tmp_path / "frob_new.3").write_text("stale")
+    stdout = io.StringIO()
+    assert process("Doxyfile", output_dir=str(tmp_path), stats=True, stdout=stdout) == 0
+    assert f"1 man pages written, {len(mtimes) - 1} unchanged" in stdout.getvalue()
+    for page in tmp_path.iterdir():
+        if page.name != "frob_new.3":
+            assert page.stat().st_mtime_ns == mtimes[page.name]
+    assert len(filecmp.dircmp("snapshot", tmp_path).diff_files) == 0
+
+# Runs in different threads must not share state.
+def test_concurrent(tmp_path: pathlib.Path) -> None:
+    fixtures = ["complex", "functions-grouped", "examples", "structs", "enums", "preprocessor"]
+    def run(fixture: str) -> int:
+        return process(os.path.join(WORKING_DIR, fixture, "Doxyfile"), output_dir=str(tmp_path / fixture), stdout=io.StringIO())
+    for _ in range(3):
+        with concurrent.futures.ThreadPoolExecutor(len(fixtures)) as executor:
+            assert list(executor.map(run, fixtures)) == [0] * len(fixtures)
+        for fixture in fixtures:
+            dcmp = filecmp.dircmp(os.path.join(WORKING_DIR, fixture, "snapshot"), tmp_path / fixture)
+            assert len(dcmp.diff_files) == 0
+            assert len(dcmp.left_only) == 0
+
+def test_generate() -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    pages = dict(generate("Doxyfile", stdout=io.StringIO()))
+    assert sorted(pages) == sorted(os.listdir("snapshot"))
+    for name, text in pages.items():
+        with open(os.path.join("snapshot", name), "r", encoding="utf-8") as fp:
+            assert fp.read() == text
+
+def test_generate_no_xml(capsys: pytest.CaptureFixture[str]) -> None:
+    with pytest.raises(RuntimeError):
+        list(generate(os.path.join(WORKING_DIR, "empty", "Doxyfile"), exclusion_pattern=".*xml"))
+    assert capsys.readouterr().err == "error: no XML files match the pattern\n"
+
+def test_compress(tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    assert process("Doxyfile", output_dir=str(tmp_path), compress="gzip") == 0
+    assert sorted(os.listdir(tmp_path)) == sorted(name + ".gz" for name in os.listdir("snapshot"))
+    for name in os.listdir("snapshot"):
+        with open(os.path.join("snapshot", name), "rb") as fp:
+            assert gzip.decompress((tmp_path / (name + ".gz")).read_bytes()) == fp.read()
+    # The gzip header records no modification time so the output is reproducible.
+    stdout = io.StringIO()
+    assert process("Doxyfile", output_dir=str(tmp_path), compress="gzip", stats=True, stdout=stdout) == 0
+    assert f"0 man pages written, {len(os.listdir(tmp_path))} unchanged" in stdout.getvalue()
+
+def test_compress_xz(tmp_path: pathlib.Path) -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    assert process("Doxyfile", output_dir=str(tmp_path), compress="xz", compress_level=1, write_queue=0) == 0
+    for name in os.listdir("snapshot"):
+        with open(os.path.join("snapshot", name), "rb") as fp:
+            assert lzma.decompress((tmp_path / (name + ".xz")).read_bytes()) == fp.read()
+
+def test_stats() -> None:
+    os.chdir(os.path.join(WORKING_DIR, "complex"))
+    stdout = io.StringIO()
+    assert process("Doxyfile", stats=True, stdout=stdout) == 0
+    assert re.search(r"^render: +\d+\.\d{3}s$", stdout.getvalue(), re.MULTILINE)
+    assert re.search(r"^\d+ references rendered ahead of time, [1-9]\d* uses$", stdout.getvalue(), re.MULTILINE)
+    assert len(filecmp.dircmp("snapshot", "man").diff_files) == 0
+
 def test_fullpath() -> None:
     assert_snapshot("functions", "snapshot-absolute-path",
                     include_path="full",
@@ -0,0 +1,57 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+from manos.ordered_set import OrderedSet
+
+import pytest
+
+def test_insertion_order() -> None:
+    items = OrderedSet(["c", "a", "b", "a"])
+    assert list(items) == ["c", "a", "b"]
+    assert list(reversed(items)) == ["b", "a", "c"]
+    assert items[0] == "c"
+    assert items[-1] == "b"
+    assert items[1:] == OrderedSet(["a", "b"])
+    assert items.index("b") == 2
+    with pytest.raises(IndexError):
+        items[3]
+
+def test_discard() -> None:
+    items = OrderedSet(["a", "b", "c", "d"])
+    items.discard("b")
+    items.discard("x")
+    assert list(items) == ["a", "c", "d"]
+    assert items.index("d") == 2
+    items.add("b")
+    assert list(items) == ["a", "c", "d", "b"]
+    assert items.pop() == "b"
+    assert items.pop(0) == "a"
+    assert list(items) == ["c", "d"]
+
+def test_update_in_place() -> None:
+    items = OrderedSet(["a", "b"])
+    alias = items
+    items.update(["c", "a"], OrderedSet(["d"]))
+    items.difference_update(["b"], {"d"})
+    assert alias is items
+    assert list(items) == ["a", "c"]
+
+def test_set_algebra_copies() -> None:
+    items = OrderedSet(["a", "b", "c"])
+    assert list(items.union(["d", "a"])) == ["a", "b", "c", "d"]
+    assert list(items.difference(["b"])) == ["a", "c"]
+    assert list(items.intersection(["c", "a"])) == ["a", "c"]
+    assert list(items) == ["a", "b", "c"]
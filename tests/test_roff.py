@@ -0,0 +1,72 @@
+#  Manos
+#  Copyright (C) 2023-2024, Henry Stratmann III
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License version 3 as
+#  published by the Free Software Foundation.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+from manos import register_handler
+from manos.__main__ import Arguments, Context, Roff, Session, HANDLERS, process_as_roff, process_children, process_text
+
+import lxml.etree
+import pytest
+
+def render(xml: str) -> str:
+    return str(process_as_roff(Context(Session(Arguments())), lxml.etree.fromstring(xml)))
+
+def test_section_depth_in_tag() -> None:
+    assert render("<sect1><title>hello world</title><para>Some text.</para></sect1>") == ".SS Hello world\n.PP\nSome text."
+
+def test_unknown_tag() -> None:
+    with pytest.raises(Exception, match="unknown node"):
+        render("<para>Some <blink>text</blink>.</para>")
+
+def test_register_handler() -> None:
+    def blockquote(ctx: Context, elem: lxml.etree._Element) -> Roff:
+        roff = Roff()
+        roff.append_macro(".RS")
+        roff.append_roff(process_children(ctx, elem))
+        roff.append_macro(".RE")
+        return roff
+    register_handler("blockquote", blockquote)
+    try:
+        assert render("<para>Quote:<blockquote>Some text.</blockquote></para>") == "Quote:\n.RS\nSome text.\n.RE"
+    finally:
+        del HANDLERS["blockquote"]
+
+# Nest elements with the given tag 'depth' levels deep inside a paragraph.
+def nest(tag: str, depth: int, text: str) -> lxml.etree._Element:
+    root = lxml.etree.Element("para")
+    node = root
+    for _ in range(depth):
+        node = lxml.etree.SubElement(node, tag)
+    node.text = text
+    return root
+
+# Nesting far beyond the Python recursion limit must not exhaust the call stack.
+def test_deeply_nested_markup() -> None:
+    depth = 3000
+    roff = process_as_roff(Context(Session(Arguments())), nest("emphasis", depth, "text"))
+    assert str(roff) == "\\f[I]" * depth + "text" + "\\f[R]" * depth
+
+def test_deeply_nested_lists() -> None:
+    depth = 2000
+    root = lxml.etree.Element("para")
+    node = root
+    for _ in range(depth):
+        node = lxml.etree.SubElement(lxml.etree.SubElement(node, "itemizedlist"), "listitem")
+    node.text = "text"
+    text = str(process_as_roff(Context(Session(Arguments())), root))
+    assert text.count(".RS") == depth
+    assert text.count(".RE") == depth
+
+def test_deeply_nested_text() -> None:
+    assert process_text(nest("bold", 5000, " text ")) == "text"
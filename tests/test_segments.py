@@ -82,3 +82,9 @@ def test_ellipsis_and_space_and_capital_clause() -> None:
         'Nothing remained...',
         'But to go home.',
     ]
+
+def test_suppression_is_a_suffix_match() -> None:
+    assert segment("The BOOK. Is here. The end.") == [
+        "The BOOK. Is here.",
+        "The end.",
+    ]